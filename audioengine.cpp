@@ -0,0 +1,90 @@
+/**
+ * @file audioengine.cpp
+ * @brief AudioEngine 구현
+ */
+
+#include "audioengine.h"
+
+#include <iostream>
+
+AudioEngine& AudioEngine::instance() {
+    static AudioEngine engine;
+    return engine;
+}
+
+bool AudioEngine::open() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return open_locked();
+}
+
+bool AudioEngine::open_locked() {
+    if (device_) return true;
+    if (failed_) return false;
+
+    const Uint64 t0 = SDL_GetTicksNS();
+    device_ = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, nullptr);
+    if (!device_) {
+        std::cout << "[오디오 출력] 디바이스 열기 실패: " << SDL_GetError() << "\n";
+        failed_ = true;
+        return false;
+    }
+
+    int frames = 0;
+    if (!SDL_GetAudioDeviceFormat(device_, &spec_, &frames) || spec_.freq <= 0 || spec_.channels <= 0) {
+        spec_.format   = SDL_AUDIO_F32;
+        spec_.channels = 2;
+        spec_.freq     = 48000;
+    }
+    latency_ = frames > 0 ? static_cast<double>(frames) / spec_.freq : 0.0;
+
+    std::cout << "[오디오 출력] 디바이스 " << spec_.channels << "ch " << spec_.freq << "Hz, 버퍼 "
+              << frames << " 샘플, 열기 " << (SDL_GetTicksNS() - t0) / SDL_NS_PER_MS << "ms\n";
+    return true;
+}
+
+void AudioEngine::close() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (!device_) return;
+    if (attached_ > 0)
+        std::cout << "[오디오 출력] 연결된 스트림 " << attached_ << "개가 남은 채 닫음\n";
+    SDL_CloseAudioDevice(device_);   // 남은 스트림은 자동으로 풀림
+    device_ = 0;
+    std::cout << "[오디오 출력] 닫음 (스트림 연결 " << attaches_ << "회, 디바이스 열기 1회)\n";
+}
+
+bool AudioEngine::output_format(SDL_AudioSpec& spec, double& latency) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (!open_locked()) return false;
+    spec    = spec_;
+    latency = latency_;
+    return true;
+}
+
+SDL_AudioStream* AudioEngine::attach(const SDL_AudioSpec& src,
+                                     SDL_AudioStreamCallback callback, void* userdata) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (!open_locked()) return nullptr;
+
+    SDL_AudioStream* stream = SDL_CreateAudioStream(&src, &spec_);
+    if (!stream) return nullptr;
+    // 콜백을 먼저 달고 묶어야 첫 요청부터 콜백이 받는다
+    if (!SDL_SetAudioStreamGetCallback(stream, callback, userdata) ||
+        !SDL_BindAudioStream(device_, stream)) {
+        std::cout << "[오디오 출력] 스트림 연결 실패: " << SDL_GetError() << "\n";
+        SDL_DestroyAudioStream(stream);
+        return nullptr;
+    }
+    ++attached_;
+    ++attaches_;
+    return stream;
+}
+
+void AudioEngine::detach(SDL_AudioStream*& stream) {
+    if (!stream) return;
+    SDL_UnbindAudioStream(stream);
+    SDL_DestroyAudioStream(stream);
+    stream = nullptr;
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    --attached_;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file audioengine.h
+ * @brief 프로세스 전체가 공유하는 SDL 오디오 출력 (디바이스 한 번만 열기)
+ *
+ *  예전에는 VideoPlayer 마다 SDL_OpenAudioDeviceStream 으로 디바이스를 열고 cleanup()
+ *  에서 닫았다. 파일을 바꿀 때마다 디바이스를 다시 여는 데 수십 ms 가 걸리고
+ *  열고 닫는 순간 딸깍 소리가 나기도 했다.
+ *
+ *  AudioEngine 은 기본 재생 디바이스를 시작 시 한 번 열어 종료까지 유지하고,
+ *  플레이어는 attach() 로 자기 SDL_AudioStream 을 만들어 디바이스에 묶는다.
+ *  묶인 스트림들은 SDL 이 믹스하므로 두 플레이어가 잠시 겹쳐도(전환 중) 문제없고,
+ *  detach() 는 스트림만 풀어 없앤다 – 디바이스는 계속 돈다.
+ *
+ *  VideoPlayer 는 PCM 링에서, AudioPlayer 는 BASS 디코딩 채널(BASS_STREAM_DECODE)에서
+ *  샘플을 꺼내 각자 콜백으로 넣는다 – 두 종류 모두 같은 디바이스로 나간다.
+ *
+ *  - 디바이스는 멈추지 않는다. 플레이어별 일시정지는 각자 콜백에서 데이터를 주지 않는 식으로.
+ *  - 모든 함수는 스레드 안전 (플레이어는 Prefetcher 작업 스레드에서 생성되고 Reaper 에서 해제됨).
+ */
+
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @class AudioEngine
+ * @brief 공유 SDL 오디오 디바이스 + 플레이어별 스트림 연결/해제
+ */
+class AudioEngine {
+public:
+    static AudioEngine& instance();
+
+    AudioEngine(const AudioEngine&)            = delete;
+    AudioEngine& operator=(const AudioEngine&) = delete;
+
+    /// @brief 기본 재생 디바이스 열기 (이미 열려 있으면 true, SDL_INIT_AUDIO 이후)
+    bool open();
+
+    /// @brief 디바이스 닫기 – 연결된 스트림이 모두 해제된 뒤, SDL_Quit 전에 호출
+    void close();
+
+    /**
+     * @brief 디바이스 출력 형식 조회 (열려 있지 않으면 엶)
+     * @param spec    디바이스 고유 포맷/레이트/채널
+     * @param latency 디바이스 버퍼 지연 (초)
+     * @return 디바이스를 열 수 없으면 false
+     */
+    bool output_format(SDL_AudioSpec& spec, double& latency);
+
+    /**
+     * @brief 플레이어 스트림 생성 후 디바이스에 연결
+     * @param src      플레이어가 넣을 데이터 형식 (디바이스 형식과 다르면 SDL 이 변환)
+     * @param callback get 콜백 (디바이스가 데이터를 요청할 때, 디바이스 스레드)
+     * @return 실패 시 nullptr
+     */
+    SDL_AudioStream* attach(const SDL_AudioSpec& src, SDL_AudioStreamCallback callback, void* userdata);
+
+    /// @brief 스트림을 디바이스에서 풀고 해제 (반환 후 콜백은 더 불리지 않음), stream 은 nullptr 로
+    void detach(SDL_AudioStream*& stream);
+
+private:
+    AudioEngine() = default;
+
+    bool open_locked();   ///< mutex_ 아래
+
+    std::mutex        mutex_;
+    SDL_AudioDeviceID device_   = 0;        ///< 0 = 닫힘
+    SDL_AudioSpec     spec_     {};
+    double            latency_  = 0.0;
+    int               attached_ = 0;        ///< 현재 연결된 스트림 수
+    uint64_t          attaches_ = 0;        ///< 누적 연결 수 (디바이스를 다시 열지 않은 전환 수)
+    bool              failed_   = false;    ///< 열기 실패 – 다시 시도하지 않음
+};
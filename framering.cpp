@@ -0,0 +1,63 @@
+/**
+ * @file framering.cpp
+ * @brief FrameRing 구현
+ */
+
+#include "framering.h"
+
+FrameRing::FrameRing(int capacity)
+    : slots_(static_cast<size_t>(capacity))
+{
+    for (auto& s : slots_) s.frame = av_frame_alloc();
+}
+
+FrameRing::~FrameRing() {
+    for (auto& s : slots_) av_frame_free(&s.frame);
+}
+
+FrameRing::Slot* FrameRing::peek_writable() {
+    std::unique_lock<std::mutex> lk(mutex_);
+    cv_.wait(lk, [&] { return aborted_ || count_ < capacity(); });
+    if (aborted_) return nullptr;
+    return &slots_[static_cast<size_t>(windex_)];
+}
+
+void FrameRing::push() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    windex_ = (windex_ + 1) % capacity();
+    ++count_;
+}
+
+FrameRing::Slot* FrameRing::peek(int offset) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (offset >= count_) return nullptr;
+    return &slots_[static_cast<size_t>((rindex_ + offset) % capacity())];
+}
+
+void FrameRing::pop() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (count_ == 0) return;
+        rindex_ = (rindex_ + 1) % capacity();
+        --count_;
+    }
+    cv_.notify_one();
+}
+
+int FrameRing::size() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return count_;
+}
+
+void FrameRing::abort() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        aborted_ = true;
+    }
+    cv_.notify_all();
+}
+
+void FrameRing::start() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    aborted_ = false;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+/**
+ * @file framering.h
+ * @brief 디코딩 스레드 → 메인 스레드 간 표시 대기 프레임 전달용 링 버퍼
+ *
+ *  단일 생산자(비디오 디코딩 스레드) / 단일 소비자(메인 스레드 update()).
+ *    생산자: peek_writable() → 슬롯 프레임에 기록 → push()
+ *    소비자: peek() 로 PTS 확인 → 텍스처 업로드 → pop()
+ *
+ *  mutex_ 는 인덱스 갱신 동안에만 잡는다. 슬롯 데이터 기록/업로드는
+ *  락 없이 수행되므로 sws_scale 과 SDL_UpdateTexture 가 서로 막지 않는다.
+ *
+ *  슬롯 프레임은 FrameBufferPool 에서 얻은 변환 버퍼이거나, 직접 업로드 경로에서
+ *  av_frame_move_ref 로 옮겨 온 디코더 프레임 참조일 수 있다.
+ */
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class FrameRing
+ * @brief 미리 할당된 N개의 AVFrame 슬롯 (PTS / serial 부착)
+ */
+class FrameRing {
+public:
+    /// 링 슬롯 하나
+    struct Slot {
+        AVFrame* frame  = nullptr; ///< 슬롯 소유 프레임 (변환 버퍼 또는 디코더 프레임 참조)
+        double   pts    = 0.0;     ///< 표시 시각 (초)
+        int      serial = 0;       ///< seek 세대 – 현재 세대와 다르면 폐기 대상
+
+        // 표시 시 변환 (VideoOptions::convert_in_texture): 디코더 프레임을 그대로 두고
+        // 업로드 시점에 잠근 텍스처 메모리로 바로 변환한다
+        AVPixelFormat dst_fmt = AV_PIX_FMT_NONE; ///< NONE = frame 을 그대로 업로드
+        int           dst_w   = 0;
+        int           dst_h   = 0;
+    };
+
+    /// @param capacity 슬롯 수 (디코더가 앞서 나갈 수 있는 프레임 수)
+    explicit FrameRing(int capacity);
+    ~FrameRing();
+
+    FrameRing(const FrameRing&)            = delete;
+    FrameRing& operator=(const FrameRing&) = delete;
+
+    /**
+     * @brief 기록 가능한 슬롯을 얻는다. 링이 가득 차 있으면 블로킹
+     * @return 기록할 슬롯, abort 상태면 nullptr
+     */
+    Slot* peek_writable();
+    /// @brief peek_writable() 로 얻은 슬롯을 소비자에게 공개
+    void  push();
+
+    /**
+     * @brief 소비 대기 중인 슬롯 조회 (블로킹하지 않음)
+     * @param offset 0 = 가장 오래된 프레임, 1 = 그다음 …
+     * @return 슬롯, 해당 위치에 프레임이 없으면 nullptr
+     */
+    Slot* peek(int offset = 0);
+    /// @brief 가장 오래된 슬롯을 반환하여 생산자가 재사용하도록 함
+    void  pop();
+
+    int  size()     const;
+    int  capacity() const { return static_cast<int>(slots_.size()); }
+
+    /// @brief peek_writable() 대기를 깨우고 이후 호출을 nullptr 로 만든다
+    void abort();
+    /// @brief abort 상태 해제
+    void start();
+
+private:
+    std::vector<Slot>       slots_;
+    int                     rindex_  = 0;  ///< 소비자 읽기 위치
+    int                     windex_  = 0;  ///< 생산자 쓰기 위치
+    int                     count_   = 0;  ///< 공개된 프레임 수
+    bool                    aborted_ = false;
+    mutable std::mutex      mutex_;
+    std::condition_variable cv_;
+};
@@ -0,0 +1,200 @@
+/**
+ * @file keyframeindex.cpp
+ * @brief KeyframeIndex 구현
+ */
+
+#include "keyframeindex.h"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <list>
+
+// ── 프로세스 전역 캐시 ───────────────────────────────────────────
+
+namespace {
+
+/// 빌드 중인 인덱스는 weak 로만 가리키고, 완성된 인덱스만 pinned 로 붙잡는다
+struct CacheEntry {
+    std::string                         path;
+    std::weak_ptr<KeyframeIndex>        weak;
+    std::shared_ptr<const KeyframeIndex> pinned;
+};
+
+std::mutex            cache_mutex;
+std::list<CacheEntry> cache;   // 앞쪽이 최근 사용
+
+} // namespace
+
+std::shared_ptr<KeyframeIndex> KeyframeIndex::acquire(const std::string& path) {
+    std::lock_guard<std::mutex> lk(cache_mutex);
+    for (auto it = cache.begin(); it != cache.end(); ) {
+        if (it->path == path) {
+            if (auto idx = it->weak.lock()) {
+                cache.splice(cache.begin(), cache, it);
+                return idx;
+            }
+        }
+        // 마지막 플레이어가 놓아 사라진 (빌드 중단된) 항목 정리
+        if (!it->pinned && it->weak.expired()) it = cache.erase(it);
+        else                                   ++it;
+    }
+
+    std::shared_ptr<KeyframeIndex> idx(new KeyframeIndex(path));
+    cache.push_front(CacheEntry{ path, idx, nullptr });
+    return idx;
+}
+
+void KeyframeIndex::retain_completed(const KeyframeIndex* idx) {
+    std::shared_ptr<const KeyframeIndex>              self;
+    std::vector<std::shared_ptr<const KeyframeIndex>> evicted;   // 소멸은 잠금 밖에서
+    {
+        std::lock_guard<std::mutex> lk(cache_mutex);
+        size_t pinned = 0;
+        for (auto& e : cache) {
+            if (e.pinned) ++pinned;
+            else if (!self) {
+                auto p = e.weak.lock();
+                if (p.get() == idx) { e.pinned = p; self = std::move(p); ++pinned; }
+            }
+        }
+        for (auto it = cache.rbegin(); it != cache.rend() && pinned > CACHE_SIZE; ++it) {
+            if (it->pinned && it->pinned != self) {
+                evicted.push_back(std::move(it->pinned));
+                --pinned;
+            }
+        }
+    }
+    // self 가 마지막 참조일 수 있음 (그 사이 밀려나고 플레이어도 놓은 경우) – 소멸자가 처리
+}
+
+KeyframeIndex::KeyframeIndex(std::string path)
+    : path_(std::move(path))
+{
+}
+
+KeyframeIndex::~KeyframeIndex() {
+    abort_ = true;
+    if (!thread_.joinable()) return;
+    // 빌드 스레드 자신이 마지막 참조를 놓은 경우 (retain_completed 직후) – 스스로 join 불가
+    if (thread_.get_id() == std::this_thread::get_id()) thread_.detach();
+    else                                                 thread_.join();
+}
+
+void KeyframeIndex::start() {
+    if (complete_.load()) return;
+    std::call_once(start_once_, [this] { thread_ = std::thread(&KeyframeIndex::build_loop, this); });
+}
+
+// ── 조회 ─────────────────────────────────────────────────────────
+
+bool KeyframeIndex::floor(double secs, Entry& out) const {
+    if (!complete_.load() && secs > built_until_.load()) return false;
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto it = std::upper_bound(entries_.begin(), entries_.end(), secs,
+                               [](double s, const Entry& e) { return s < e.secs; });
+    if (it == entries_.begin()) return false;
+    out = *std::prev(it);
+    return true;
+}
+
+bool KeyframeIndex::nearest(double secs, Entry& out) const {
+    if (!complete_.load() && secs > built_until_.load()) return false;
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (entries_.empty()) return false;
+
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), secs,
+                               [](const Entry& e, double s) { return e.secs < s; });
+    if (it == entries_.end())   { out = entries_.back(); return true; }
+    if (it == entries_.begin()) { out = *it;             return true; }
+
+    const Entry& after  = *it;
+    const Entry& before = *std::prev(it);
+    out = (after.secs - secs < secs - before.secs) ? after : before;
+    return true;
+}
+
+size_t KeyframeIndex::copy_since(size_t from, std::vector<Entry>& out) const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (from < entries_.size())
+        out.insert(out.end(), entries_.begin() + static_cast<std::ptrdiff_t>(from), entries_.end());
+    return entries_.size();
+}
+
+size_t KeyframeIndex::size() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return entries_.size();
+}
+
+// ── 빌드 스레드 ──────────────────────────────────────────────────
+
+/**
+ * @brief 파일을 처음부터 끝까지 읽으며 비디오 키프레임 위치 수집
+ *
+ *  대상 외 스트림은 AVDISCARD_ALL 로 버려 디먹서 작업을 줄인다.
+ *  재생 스레드와 디스크/CPU 를 다투지 않도록 낮은 우선순위로 돈다.
+ */
+void KeyframeIndex::build_loop() {
+    SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_LOW);
+    const Uint64 t0 = SDL_GetTicksNS();
+
+    AVFormatContext* fmt = nullptr;
+    if (avformat_open_input(&fmt, path_.c_str(), nullptr, nullptr) < 0) {
+        complete_ = true;
+        return;
+    }
+
+    const int vidx = (avformat_find_stream_info(fmt, nullptr) >= 0)
+                   ? av_find_best_stream(fmt, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0)
+                   : -1;
+    if (vidx < 0) {
+        avformat_close_input(&fmt);
+        complete_ = true;
+        return;
+    }
+    stream_index_ = vidx;
+
+    for (unsigned i = 0; i < fmt->nb_streams; ++i)
+        if (static_cast<int>(i) != vidx) fmt->streams[i]->discard = AVDISCARD_ALL;
+
+    const AVRational tb  = fmt->streams[vidx]->time_base;
+    AVPacket*        pkt = av_packet_alloc();
+
+    while (!abort_.load() && av_read_frame(fmt, pkt) >= 0) {
+        if (pkt->stream_index == vidx) {
+            // ts 는 디먹서 인덱스 주입용 (dts), secs 는 표시 시각 (pts) – B-frame 이면 pts > dts
+            const int64_t ts   = (pkt->dts != AV_NOPTS_VALUE) ? pkt->dts : pkt->pts;
+            const int64_t show = (pkt->pts != AV_NOPTS_VALUE) ? pkt->pts : pkt->dts;
+            if (ts != AV_NOPTS_VALUE) {
+                const double secs = show * av_q2d(tb);
+                if ((pkt->flags & AV_PKT_FLAG_KEY) && pkt->pos >= 0) {
+                    std::lock_guard<std::mutex> lk(mutex_);
+                    const Entry e{ ts, pkt->pos, secs };
+                    if (entries_.empty() || entries_.back().secs < secs)
+                        entries_.push_back(e);
+                    else   // 타임스탬프 역전 (TS 불연속 등) – 정렬 유지
+                        entries_.insert(std::upper_bound(entries_.begin(), entries_.end(), secs,
+                                            [](double s, const Entry& x) { return s < x.secs; }), e);
+                }
+                built_until_ = std::max(built_until_.load(), secs);
+            }
+        }
+        av_packet_unref(pkt);
+    }
+
+    if (!abort_.load()) {
+        complete_ = true;
+        std::cout << "[키프레임 인덱스] " << size() << "개, "
+                  << (SDL_GetTicksNS() - t0) / SDL_NS_PER_MS << "ms\n";
+    }
+
+    av_packet_free(&pkt);
+    avformat_close_input(&fmt);
+
+    // 마지막 동작 – 이 뒤로 this 를 건드리지 않는다 (여기서 소멸될 수 있음)
+    if (complete_.load()) retain_completed(this);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+/**
+ * @file keyframeindex.h
+ * @brief 파일별 비디오 키프레임 인덱스 (PTS → 바이트 오프셋)
+ *
+ *  인덱스가 부실한 컨테이너(큐가 듬성한 MKV, 인덱스가 없는 TS)에서는
+ *  av_seek_frame 이 파일을 훑느라 수 초씩 걸린다. KeyframeIndex 는
+ *  재생 중 백그라운드 스레드에서 별도 AVFormatContext 로 파일을 끝까지 읽으며
+ *  키프레임 위치를 모아 두고, 이후 seek 는 이 표를 보고 바로 이동한다.
+ *
+ *  - 같은 파일을 다시 열면 acquire() 가 프로세스 전역 캐시의 인덱스를 돌려준다.
+ *    캐시는 완성된 인덱스만 붙잡아 두고, 빌드 중인 인덱스는 weak_ptr 로만 가리킨다.
+ *  - 빌드는 start() 에서 시작한다 (플레이어가 실제로 재생을 시작할 때 – 미리 열기 중엔 아님).
+ *  - 빌드 중에도 이미 훑은 구간은 조회할 수 있다 (built_until()).
+ *  - 빌드 스레드는 낮은 우선순위로 돌며, 마지막 플레이어가 놓으면 중단/join 된다
+ *    (재생이 끝난 파일의 전체 스캔이 다음 파일의 I/O 와 다투지 않도록).
+ */
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class KeyframeIndex
+ * @brief 백그라운드에서 만들어지는 키프레임 표 (스레드 안전 조회)
+ */
+class KeyframeIndex {
+public:
+    /// 키프레임 하나
+    struct Entry {
+        int64_t ts;    ///< 스트림 time_base 기준 타임스탬프 (dts 우선, 없으면 pts – 디먹서 인덱스 주입용)
+        int64_t pos;   ///< 패킷 바이트 오프셋
+        double  secs;  ///< 표시 시각 (초, pts 우선 – B-frame 스트림에서 dts 보다 늦음, start_time 보정 전)
+    };
+
+    /**
+     * @brief 파일의 인덱스를 얻는다 (캐시에 있으면 재사용, 없으면 생성 – 빌드는 start() 에서)
+     * @param path 파일 경로 (UTF-8)
+     */
+    static std::shared_ptr<KeyframeIndex> acquire(const std::string& path);
+
+    ~KeyframeIndex();
+
+    /// @brief 빌드 스레드 시작 (이미 시작했거나 완성된 인덱스면 무시, 스레드 안전)
+    void start();
+
+    KeyframeIndex(const KeyframeIndex&)            = delete;
+    KeyframeIndex& operator=(const KeyframeIndex&) = delete;
+
+    /**
+     * @brief secs 이하의 마지막 키프레임
+     * @return 이미 훑은 구간 안에 있으면 true
+     */
+    bool floor(double secs, Entry& out) const;
+
+    /**
+     * @brief secs 에 가장 가까운 키프레임 (앞/뒤 무관)
+     * @return 아직 훑지 않은 구간이거나 인덱스가 비어 있으면 false
+     */
+    bool nearest(double secs, Entry& out) const;
+
+    /**
+     * @brief from 번째 이후 항목을 out 에 덧붙임 (디먹서 인덱스 주입용)
+     * @return 현재 항목 수 (다음 호출의 from)
+     */
+    size_t copy_since(size_t from, std::vector<Entry>& out) const;
+
+    int    stream_index() const { return stream_index_.load(); }  ///< 인덱스 대상 스트림 (-1 = 아직 모름)
+    bool   complete()     const { return complete_.load(); }      ///< 파일 끝까지 훑었는지
+    double built_until()  const { return built_until_.load(); }   ///< 훑은 구간 끝 (초)
+    size_t size()         const;
+
+private:
+    explicit KeyframeIndex(std::string path);
+
+    void build_loop();
+
+    /// 빌드 완료 시 캐시가 이 인덱스를 붙잡도록 (빌드 스레드의 마지막 동작)
+    static void retain_completed(const KeyframeIndex* idx);
+
+    static constexpr size_t CACHE_SIZE = 8;   ///< 프로세스 전역 캐시에 남길 완성된 인덱스 수
+
+    std::string         path_;
+    std::vector<Entry>  entries_;             ///< secs 오름차순
+    mutable std::mutex  mutex_;               ///< entries_ 보호
+    std::thread         thread_;
+    std::once_flag      start_once_;
+    std::atomic<bool>   abort_        {false};
+    std::atomic<bool>   complete_     {false};
+    std::atomic<double> built_until_  {0.0};
+    std::atomic<int>    stream_index_ {-1};
+};
@@ -4,15 +4,21 @@
  *
  *  create_player() → player->play() 로 시작
  *  메인 루프: player->update() → mr.render(player)
- *  교체 시:  player.reset() (소멸자가 stop() 호출) → 새 플레이어 생성 → play()
+ *  교체 시:  기존 플레이어는 Reaper 가 해제, 새 플레이어는 Prefetcher 가 백그라운드에서 생성
+ *            → 준비되면 play() (다음 항목은 미리 열어 두므로 보통 바로 시작)
  */
 
+#include "audioengine.h"
 #include "mediaplayer.h"
 #include "mediarender.h"
+#include "prefetcher.h"
+#include "probecache.h"
+#include "reaper.h"
 #include "args.hpp"
 #include "fnutil.hpp"
 #include "util.hpp"
 
+#include <algorithm>
 #include <climits>
 #include <filesystem>
 #include <fstream>
@@ -71,6 +77,20 @@ static T safe_parse(const std::string& s, T fallback) {
     return fallback;
 }
 
+/**
+ * @brief 디코더 스레딩 방식 문자열 파싱 ("auto" / "frame" / "slice" / "both")
+ * @return 알 수 없는 값이면 fallback
+ */
+static VideoOptions::ThreadType parse_thread_type(const std::wstring& s,
+                                                  VideoOptions::ThreadType fallback) {
+    const auto l = util::to_lower_ascii(s);
+    if (l == L"auto")  return VideoOptions::ThreadType::Auto;
+    if (l == L"frame") return VideoOptions::ThreadType::Frame;
+    if (l == L"slice") return VideoOptions::ThreadType::Slice;
+    if (l == L"both")  return VideoOptions::ThreadType::Both;
+    return fallback;
+}
+
 /**
  * @brief "WxH" 또는 "W,H" 형태의 문자열을 파싱하여 a,b 에 저장
  * @return 파싱 성공 시 true
@@ -194,6 +214,7 @@ static AppConfig load_config(const Args& args,
     if (conf.count(L"delay_after"))     cfg.delay_after     = safe_parse<float>(cs(L"delay_after"),     cfg.delay_after);
     if (conf.count(L"image_display"))   cfg.image_display   = safe_parse<float>(cs(L"image_display"),   cfg.image_display);
     if (conf.count(L"short_threshold")) cfg.short_threshold = safe_parse<float>(cs(L"short_threshold"), cfg.short_threshold);
+    if (conf.count(L"crossfade"))       cfg.crossfade       = safe_parse<float>(cs(L"crossfade"),       cfg.crossfade);
 
     auto load_exts = [&](const std::wstring& key,
                           std::initializer_list<std::wstring> defaults)
@@ -210,14 +231,44 @@ static AppConfig load_config(const Args& args,
     if (conf.count(L"subtitle_font")) cfg.subtitle_font = cs(L"subtitle_font");
     if (conf.count(L"subtitle_size")) cfg.subtitle_size = safe_parse<int>(cs(L"subtitle_size"), cfg.subtitle_size);
 
+    // 디코더 스레딩: "auto" 또는 숫자 (0 = auto)
+    auto& vo = cfg.video;
+    if (conf.count(L"decoder_threads"))     vo.decoder_threads     = safe_parse<int>(cs(L"decoder_threads"), 0);
+    if (conf.count(L"decoder_thread_type")) vo.decoder_thread_type = parse_thread_type(conf.at(L"decoder_thread_type"), vo.decoder_thread_type);
+    if (conf.count(L"sws_threads"))         vo.sws_threads         = safe_parse<int>(cs(L"sws_threads"), 0);
+    if (conf.count(L"scale_to_output"))     vo.scale_to_output     = is_true(conf.at(L"scale_to_output"));
+    if (conf.count(L"scrub_fast_decode"))   vo.scrub_fast_decode   = is_true(conf.at(L"scrub_fast_decode"));
+    if (conf.count(L"huge_pages"))          vo.huge_pages          = is_true(conf.at(L"huge_pages"));
+    if (conf.count(L"convert_in_texture"))  vo.convert_in_texture  = is_true(conf.at(L"convert_in_texture"));
+    if (conf.count(L"accurate_seek"))       vo.accurate_seek       = is_true(conf.at(L"accurate_seek"));
+    if (conf.count(L"readahead_mb"))        vo.readahead_mb        = safe_parse<int>(cs(L"readahead_mb"), 0);
+    if (conf.count(L"audio_buffer_ms"))     vo.audio_buffer_ms     = safe_parse<int>(cs(L"audio_buffer_ms"), vo.audio_buffer_ms);
+    if (conf.count(L"thumbnail_cpu"))       cfg.thumbnail_cpu      = safe_parse<float>(cs(L"thumbnail_cpu"), cfg.thumbnail_cpu);
+
     auto as = [&](const std::wstring& k) { return util::wstring_to_utf8(args.get(k)); };
     if (args.has(L"--volume"))          cfg.volume          = safe_parse<float>(as(L"--volume"),          cfg.volume);
     if (args.has(L"--delay"))           cfg.delay_after     = safe_parse<float>(as(L"--delay"),           cfg.delay_after);
     if (args.has(L"--image-display"))   cfg.image_display   = safe_parse<float>(as(L"--image-display"),   cfg.image_display);
     if (args.has(L"--short-threshold")) cfg.short_threshold = safe_parse<float>(as(L"--short-threshold"), cfg.short_threshold);
+    if (args.has(L"--crossfade"))       cfg.crossfade       = safe_parse<float>(as(L"--crossfade"),       cfg.crossfade);
     if (args.has(L"--subtitle-font"))   cfg.subtitle_font   = as(L"--subtitle-font");
     if (args.has(L"--subtitle-size"))   cfg.subtitle_size   = safe_parse<int>(as(L"--subtitle-size"),     cfg.subtitle_size);
     if (args.get_bool(L"--fullscreen")) cfg.fullscreen = true;
+    if (args.has(L"--decoder-threads"))     vo.decoder_threads     = safe_parse<int>(as(L"--decoder-threads"), 0);
+    if (args.has(L"--decoder-thread-type")) vo.decoder_thread_type = parse_thread_type(args.get(L"--decoder-thread-type"), vo.decoder_thread_type);
+    if (args.has(L"--sws-threads"))         vo.sws_threads         = safe_parse<int>(as(L"--sws-threads"), 0);
+    if (args.get_bool(L"--native-size"))    vo.scale_to_output     = false;
+    if (args.get_bool(L"--huge-pages"))     vo.huge_pages          = true;
+    if (args.get_bool(L"--convert-in-texture")) vo.convert_in_texture = true;
+    if (args.get_bool(L"--fast-seek"))      vo.accurate_seek       = false;
+    if (args.has(L"--readahead-mb"))        vo.readahead_mb        = safe_parse<int>(as(L"--readahead-mb"), 0);
+    if (args.has(L"--audio-buffer-ms"))     vo.audio_buffer_ms     = safe_parse<int>(as(L"--audio-buffer-ms"), vo.audio_buffer_ms);
+    if (args.has(L"--thumbnail-cpu"))       cfg.thumbnail_cpu      = safe_parse<float>(as(L"--thumbnail-cpu"), cfg.thumbnail_cpu);
+    vo.decoder_threads = std::max(0, vo.decoder_threads);
+    vo.sws_threads     = std::max(0, vo.sws_threads);
+    vo.readahead_mb    = std::clamp(vo.readahead_mb, 0, 1024);
+    vo.audio_buffer_ms = std::clamp(vo.audio_buffer_ms, 50, 5000);
+    cfg.crossfade      = std::min(cfg.crossfade, 10.0f);
 
     if (args.has(L"--geometry")) parse_geometry(args.get(L"--geometry"), cfg.win_w, cfg.win_h, cfg.win_x, cfg.win_y);
     if (args.has(L"-wh"))        parse_pair(args.get(L"-wh"), cfg.win_w, cfg.win_h);
@@ -236,12 +287,15 @@ static AppConfig load_config(const Args& args,
 
 /**
  * @brief 확장자를 판단해 적절한 MediaPlayer 인스턴스를 만들고 play()를 호출합니다.
+ * @param start false 면 미리 열기용: 비디오는 일시정지 상태로 디코딩만 시작, 오디오는 재생하지 않음
+ *              (Prefetcher 작업 스레드에서 호출되므로 이미지는 대상이 아님)
  * @return 유효 플레이어 또는 nullptr (로드 실패)
  */
 static std::unique_ptr<MediaPlayer> create_player(
     const std::filesystem::path& path,
     const AppConfig&             cfg,
-    SDL_Renderer*                renderer)
+    SDL_Renderer*                renderer,
+    bool                         start = true)
 {
     const std::wstring ext  = fnutil::get_extension(path.wstring()); // 확장자 추출 (소문자 변환 포함)
     const std::string  utf8 = util::wstring_to_utf8(path.wstring());
@@ -263,12 +317,17 @@ static std::unique_ptr<MediaPlayer> create_player(
 
     // ── 비디오 ───────────────────────────────────────────────────
     if (cfg.video_exts.count(ext)) {
-        auto p = std::make_unique<VideoPlayer>(utf8.c_str(), renderer);
+        auto p = std::make_unique<VideoPlayer>(utf8.c_str(), renderer, cfg.video);
         if (!p->is_valid()) {
             std::wcout << L"[비디오 로드 실패] " << path.wstring() << L" → 스킵\n";
             return nullptr;
         }
         p->set_volume(cfg.volume);
+        if (!start) {
+            p->toggle_pause();  // 클록 0 에 멈춘 채 링/큐만 채워 둔다
+            p->play();
+            return p;
+        }
         p->play();  // 디코딩 스레드 시작
         std::wcout << L"[비디오] " << path.wstring()
                    << L" (" << util::to_wstring(util::sec2str(p->get_length())) << L")\n";
@@ -282,6 +341,7 @@ static std::unique_ptr<MediaPlayer> create_player(
             std::wcout << L"[오디오 로드 실패] " << path.wstring() << L"\n";
             return nullptr;
         }
+        if (!start) return p;
         p->play();
         std::wcout << L"[오디오] " << path.wstring()
                    << L" (" << util::to_wstring(util::sec2str(p->get_length())) << L")\n";
@@ -313,17 +373,151 @@ static void update_title(MediaRenderer& mr,
 }
 
 /**
- * @brief 플레이어 교체: 기존 stop() → 새 생성 → play()
+ * @brief 현재 렌더 출력 크기(픽셀)를 플레이어에 통지 (비디오 축소 변환용)
+ */
+static void sync_output_size(MediaRenderer& mr, MediaPlayer* player) {
+    if (!player) return;
+    int w = 0, h = 0;
+    if (SDL_GetCurrentRenderOutputSize(mr.get_renderer(), &w, &h))
+        player->set_output_size(w, h);
+}
+
+/**
+ * @brief 창이 화면에 보이는지 (최소화 / 숨김 / 다른 창에 완전히 가려짐이면 false)
+ */
+static bool window_visible(MediaRenderer& mr) {
+    const SDL_WindowFlags flags = SDL_GetWindowFlags(mr.get_window());
+    return (flags & (SDL_WINDOW_MINIMIZED | SDL_WINDOW_HIDDEN | SDL_WINDOW_OCCLUDED)) == 0;
+}
+
+/**
+ * @brief 백그라운드에서 연 플레이어 재생 시작 (create_player(..., false) 의 나머지)
+ */
+static void start_player(MediaPlayer* player,
+                         const std::filesystem::path& path,
+                         const AppConfig& cfg)
+{
+    player->set_volume(cfg.volume);  // 여는 동안 볼륨이 바뀌었을 수 있음
+    const bool video = dynamic_cast<VideoPlayer*>(player) != nullptr;
+    if (video) player->toggle_pause();
+    else       player->play();
+    std::wcout << (video ? L"[비디오] " : L"[오디오] ") << path.wstring()
+               << L" (" << util::to_wstring(util::sec2str(player->get_length())) << L")\n";
+}
+
+/**
+ * @brief 작업 스레드용 플레이어 생성 함수
+ * @return 이미지는 렌더러(텍스처 생성)가 필요해 메인 스레드 밖에서 만들 수 없으므로 빈 함수
+ *         (Prefetcher 는 파일 캐시 예열만 한다)
+ */
+static Prefetcher::Factory player_factory(const std::filesystem::path& path,
+                                          const AppConfig& cfg,
+                                          SDL_Renderer* renderer)
+{
+    if (cfg.image_exts.count(fnutil::get_extension(path.wstring()))) return {};
+    return [path, cfg, renderer]() { return create_player(path, cfg, renderer, false); };
+}
+
+/**
+ * @brief 현재 항목 다음 플레이리스트 항목을 백그라운드에서 미리 열기
+ */
+static void prefetch_next(Prefetcher& prefetch,
+                          const std::vector<std::filesystem::path>& playlist,
+                          size_t idx,
+                          const AppConfig& cfg,
+                          SDL_Renderer* renderer)
+{
+    if (playlist.size() < 2) return;
+    const std::filesystem::path& next = playlist[(idx + 1) % playlist.size()];
+    prefetch.request(next, player_factory(next, cfg, renderer));
+}
+
+/// 백그라운드에서 여는 중인 전환 (메인 스레드 전용)
+struct PendingLoad {
+    bool   active = false;
+    size_t idx    = 0;
+    Uint64 t0     = 0;   ///< 전환 요청 시각 (ns)
+};
+
+/**
+ * @brief 새 플레이어가 준비된 뒤 공통 처리 (출력 크기, 썸네일, 다음 항목 미리 열기)
+ */
+static void finish_load(MediaPlayer* player,
+                        Prefetcher&  prefetch,
+                        const std::vector<std::filesystem::path>& playlist,
+                        const AppConfig& cfg,
+                        MediaRenderer&   mr,
+                        size_t idx)
+{
+    sync_output_size(mr, player);
+    if (player) player->set_visible(window_visible(mr));
+    // 호버 썸네일은 비디오에만 (이미지/오디오는 끔)
+    mr.set_thumbnail_source(dynamic_cast<VideoPlayer*>(player)
+                            ? util::wstring_to_utf8(playlist[idx].wstring()) : std::string{});
+    prefetch_next(prefetch, playlist, idx, cfg, mr.get_renderer());
+}
+
+/**
+ * @brief 여는 중인 플레이어가 준비되었으면 받아서 재생 시작 (매 프레임 호출, 블로킹 없음)
+ */
+static void poll_load(std::unique_ptr<MediaPlayer>& player,
+                      PendingLoad&                  pending,
+                      Prefetcher&                   prefetch,
+                      const std::vector<std::filesystem::path>& playlist,
+                      const AppConfig&              cfg,
+                      MediaRenderer&                mr)
+{
+    if (!pending.active) return;
+
+    const std::filesystem::path& path = playlist[pending.idx];
+    std::unique_ptr<MediaPlayer> ready;
+    if (!prefetch.poll(path, ready)) return;
+
+    pending.active = false;
+    mr.set_loading({});
+    player = std::move(ready);
+    if (player) start_player(player.get(), path, cfg);
+    std::cout << "[전환] 대기 " << (SDL_GetTicksNS() - pending.t0) / SDL_NS_PER_MS << "ms\n";
+    finish_load(player.get(), prefetch, playlist, cfg, mr, pending.idx);
+}
+
+/**
+ * @brief 플레이어 교체 요청
+ *
+ *  기존 플레이어는 Reaper 에서 stop() + cleanup(), 새 플레이어는 Prefetcher 작업 스레드에서
+ *  연다 (미리 열어 둔 것이 있으면 그대로 사용). 메인 루프는 그동안 안내 문구를 렌더링하고
+ *  poll_load() 가 준비된 플레이어를 받는다. 이미지는 렌더러가 필요하므로 여기서 바로 연다.
  */
 static void load_media(std::unique_ptr<MediaPlayer>& player,
-                       const std::filesystem::path&  path,
+                       PendingLoad&                  pending,
+                       Prefetcher&                   prefetch,
+                       Reaper&                       reaper,
+                       const std::vector<std::filesystem::path>& playlist,
                        const AppConfig&              cfg,
                        MediaRenderer&                mr,
-                       size_t idx, size_t total)
+                       size_t idx)
 {
-    player.reset();  // 소멸자에서 stop() + join 자동 호출
-    player = create_player(path, cfg, mr.get_renderer());
-    update_title(mr, path, idx, total);
+    const std::filesystem::path& path = playlist[idx];
+
+    reaper.retire(std::move(player));  // 소멸자의 stop() + join 은 Reaper 스레드에서
+    mr.set_thumbnail_source({});
+    update_title(mr, path, idx, playlist.size());
+
+    Prefetcher::Factory factory = player_factory(path, cfg, mr.get_renderer());
+    if (!factory) {
+        pending.active = false;
+        mr.set_loading({});
+        const Uint64 t0 = SDL_GetTicksNS();
+        player = create_player(path, cfg, mr.get_renderer());
+        std::cout << "[전환] 열기 " << (SDL_GetTicksNS() - t0) / SDL_NS_PER_MS << "ms\n";
+        finish_load(player.get(), prefetch, playlist, cfg, mr, idx);
+        return;
+    }
+
+    prefetch.request(path, std::move(factory), false);  // 이미 미리 여는 중이면 그대로 사용
+    pending = { true, idx, SDL_GetTicksNS() };
+    mr.set_loading(util::wstring_to_utf8(path.filename().wstring()));
+    poll_load(player, pending, prefetch, playlist, cfg, mr);  // 미리 열려 있으면 바로 시작
 }
 
 // ════════════════════════════════════════════════════════════════════
@@ -355,23 +549,41 @@ static bool handle_events(MediaRenderer&  mr,
 
         if (ev.type == SDL_EVENT_QUIT) return false;
 
+        if (ev.type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED) {
+            sync_output_size(mr, player);
+            continue;
+        }
+
+        // 최소화 / 숨김 / 가려짐 ↔ 복원 – 보이지 않는 동안 비디오 디코딩/렌더링 중지
+        if (ev.type == SDL_EVENT_WINDOW_MINIMIZED || ev.type == SDL_EVENT_WINDOW_HIDDEN  ||
+            ev.type == SDL_EVENT_WINDOW_OCCLUDED  || ev.type == SDL_EVENT_WINDOW_RESTORED ||
+            ev.type == SDL_EVENT_WINDOW_SHOWN     || ev.type == SDL_EVENT_WINDOW_EXPOSED)
+        {
+            if (player) player->set_visible(window_visible(mr));
+            continue;
+        }
+
         // 마우스: 누름
         if (ev.type == SDL_EVENT_MOUSE_BUTTON_DOWN &&
             ev.button.button == SDL_BUTTON_LEFT)
         {
             if (mr.is_over_bar(ev.button.y)) {
                 bar_dragging = true;
-                MediaRenderer::seek_to_progress(player, mr.x_to_progress(ev.button.x));
+                MediaRenderer::seek_to_progress(player, mr.x_to_progress(ev.button.x), true);
             }
         }
-        // 마우스: 드래그
+        // 마우스: 드래그 – 키프레임 미리보기 (목표는 플레이어가 합침)
         if (ev.type == SDL_EVENT_MOUSE_MOTION && bar_dragging)
-            MediaRenderer::seek_to_progress(player, mr.x_to_progress(ev.motion.x));
+            MediaRenderer::seek_to_progress(player, mr.x_to_progress(ev.motion.x), true);
 
-        // 마우스: 뗌
+        // 마우스: 뗌 – 놓은 위치로 정확한 seek 한 번
         if (ev.type == SDL_EVENT_MOUSE_BUTTON_UP &&
             ev.button.button == SDL_BUTTON_LEFT)
+        {
+            if (bar_dragging)
+                MediaRenderer::seek_to_progress(player, mr.x_to_progress(ev.button.x));
             bar_dragging = false;
+        }
 
         if (ev.type != SDL_EVENT_KEY_DOWN) continue;
 
@@ -482,6 +694,109 @@ static bool check_auto_advance(MediaPlayer*     player,
     return true;  // 비디오/이미지: 즉시 전진
 }
 
+// ── 오디오 연속 재생 (gapless / 크로스페이드) ───────────────────────
+
+/// 다음 곡으로 넘어간 뒤 끝나기를 기다리는 이전 곡 (메인 스레드 전용)
+struct Crossfade {
+    std::unique_ptr<MediaPlayer> out;          ///< 이전 곡 (끝나거나 시한이 지나면 Reaper 로)
+    Uint64                       t0     = 0;   ///< 겹침 시작 시각 (ns)
+    Uint64                       end_ns = 0;   ///< 늦어도 이 시각에 정리 (ns)
+};
+
+/// gapless: 남은 시간이 이보다 짧으면 다음 곡을 걸어 둠 (메인 루프 주기 ≈ 8ms + vsync 의 몇 배, 초)
+static constexpr double GAPLESS_LEAD_SEC = 0.1;
+
+/**
+ * @brief 오디오 곡 끝에서 미리 열어 둔 다음 곡으로 이어서 재생 (cfg.crossfade >= 0)
+ *
+ *  다음 항목은 prefetch_next() 가 이미 열어 두었으므로, 남은 시간이 크로스페이드 길이
+ *  이하가 되면 그 플레이어를 받아 바로 재생하고 두 곡의 볼륨을 equal-power 곡선으로 교차시킨다.
+ *  gapless 는 GAPLESS_LEAD_SEC 전에 다음 곡을 queue_next() 로 걸어 두고, 실제 이음은
+ *  이전 곡 디코딩이 끝나는 순간 오디오 콜백에서 샘플 단위로 한다 (메인 루프 주기와 무관).
+ *  이 창을 놓쳐 이전 곡이 막 끝났어도 다음 곡이 준비되어 있으면 바로 이어 재생한다.
+ *  다음 항목이 오디오가 아니거나 아직 준비되지 않았으면 기존 경로(종료 감지 → delay_after)로 넘어간다.
+ * @return 전환했으면 true (player / current_idx 갱신)
+ */
+static bool try_audio_transition(std::unique_ptr<MediaPlayer>& player,
+                                 Crossfade&                    fade,
+                                 Prefetcher&                   prefetch,
+                                 Reaper&                       reaper,
+                                 const PendingLoad&            pending,
+                                 const std::vector<std::filesystem::path>& playlist,
+                                 const AppConfig&              cfg,
+                                 MediaRenderer&                mr,
+                                 size_t&                       current_idx)
+{
+    if (cfg.crossfade < 0.0f || fade.out || pending.active || playlist.size() < 2) return false;
+
+    auto* ap = dynamic_cast<AudioPlayer*>(player.get());
+    if (!ap || !(ap->is_playing() || ap->is_ended())) return false;
+    const double len = ap->get_length();
+    if (len < static_cast<double>(cfg.short_threshold)) return false;   // 짧은 곡은 반복 재생
+    const double left = len - ap->get_position();
+    if (left > (cfg.crossfade > 0.0f ? cfg.crossfade : GAPLESS_LEAD_SEC)) return false;
+
+    const size_t                 next_idx  = (current_idx + 1) % playlist.size();
+    const std::filesystem::path& next_path = playlist[next_idx];
+    if (!cfg.audio_exts.count(fnutil::get_extension(next_path.wstring()))) return false;
+    if (!prefetch.ready(next_path)) return false;
+
+    std::unique_ptr<MediaPlayer> next;
+    Prefetcher::Cost             cost;
+    prefetch.poll(next_path, next, &cost);
+    auto* np = dynamic_cast<AudioPlayer*>(next.get());
+    if (!np) {   // 열기 실패 – 종료 후 기존 경로에서 다시 시도
+        reaper.retire(std::move(next));
+        return false;
+    }
+
+    if (cfg.crossfade > 0.0f && !ap->is_ended()) {
+        np->set_volume(0.0f);
+        np->fade_to(cfg.volume, cfg.crossfade);
+        ap->fade_to(0.0f, cfg.crossfade);
+        np->play();
+    } else {
+        np->set_volume(cfg.volume);
+        if (ap->is_ended()) np->play();
+        else                ap->queue_next(np);   // ap 는 fade.out 으로 남아 np 보다 먼저 해제됨
+    }
+
+    fade.out    = std::move(player);
+    fade.t0     = SDL_GetTicksNS();
+    fade.end_ns = fade.t0 + static_cast<Uint64>((std::max(left, 0.0) + 0.5) * SDL_NS_PER_SECOND);
+    player      = std::move(next);
+    current_idx = next_idx;
+
+    update_title(mr, next_path, next_idx, playlist.size());
+    std::cout << "[전환] " << (cfg.crossfade > 0.0f ? "크로스페이드 " + std::to_string(cfg.crossfade).substr(0, 4) + "s"
+                                                    : std::string("gapless"))
+              << " (남은 " << static_cast<int>(left * 1000.0) << "ms, 미리 열기 "
+              << static_cast<int>(cost.open_ms) << "ms / CPU " << static_cast<int>(cost.cpu_ms) << "ms"
+              << (cost.buffer_mb > 0.0 ? " / 버퍼 " + std::to_string(static_cast<int>(cost.buffer_mb + 0.5)) + "MB"
+                                       : std::string{})
+              << ")\n";
+    finish_load(player.get(), prefetch, playlist, cfg, mr, next_idx);
+    return true;
+}
+
+/**
+ * @brief 이전 곡 볼륨 램프 진행, 끝났으면(또는 force) 겹친 시간을 출력하고 Reaper 로
+ */
+static void update_crossfade(Crossfade& fade, Reaper& reaper, bool force = false) {
+    if (!fade.out) return;
+    fade.out->update();
+
+    const Uint64 now = SDL_GetTicksNS();
+    if (!force && !fade.out->is_ended() && now < fade.end_ns) return;
+
+    // 강제 정리는 곧 현재 곡도 바뀌는 경우 – 걸어 둔 gapless 이음을 취소
+    if (force)
+        if (auto* ap = dynamic_cast<AudioPlayer*>(fade.out.get())) ap->queue_next(nullptr);
+
+    std::cout << "[전환] 이전 곡 해제 (전환 후 " << (now - fade.t0) / SDL_NS_PER_MS << "ms)\n";
+    reaper.retire(std::move(fade.out));
+}
+
 // ════════════════════════════════════════════════════════════════════
 //  MAIN
 // ════════════════════════════════════════════════════════════════════
@@ -493,7 +808,8 @@ int main(int argc, char* argv[]) {
     util::set_console_encoding(util::codepage::UTF8);
     std::wcout << L"🎵 MP Media Player v3.5\n\n";
 
-    if (!bass::init(-1, 44100, 0)) {
+    // BASS 는 디코딩만 (장치 0 = 출력 없음) – 소리는 AudioEngine 의 SDL 디바이스로 나간다
+    if (!bass::init(0, 44100, 0)) {
         std::cerr << "BASS_Init 실패!\n";
         return 1;
     }
@@ -503,6 +819,12 @@ int main(int argc, char* argv[]) {
         L"--x", L"--y", L"--width", L"--height",
         L"-xy", L"-wh", L"--geometry",
         L"--subtitle-font", L"--subtitle-size",
+        L"--decoder-threads", L"--decoder-thread-type",
+        L"--sws-threads",
+        L"--thumbnail-cpu",
+        L"--readahead-mb",
+        L"--audio-buffer-ms",
+        L"--crossfade",
     };
     Args arg_parser(argc, argv, {
         .verify_exists      = true,
@@ -524,7 +846,18 @@ int main(int argc, char* argv[]) {
             << L"  --short-threshold N      반복 재생 임계 길이(초)\n"
             << L"  --subtitle-font <경로>   자막 폰트 파일 (.ttf/.otf)\n"
             << L"  --subtitle-size N        자막 폰트 크기 (기본 28)\n"
-            << L"  --fullscreen             전체화면 시작\n\n"
+            << L"  --fullscreen             전체화면 시작\n"
+            << L"  --decoder-threads N      비디오 디코더 스레드 수 (auto/0 = 자동)\n"
+            << L"  --decoder-thread-type T  디코더 스레딩 auto/frame/slice/both\n"
+            << L"  --sws-threads N          RGBA 변환 스레드 수 (0 = 자동, 1 = 단일)\n"
+            << L"  --thumbnail-cpu N        호버 썸네일 생성 CPU 비율 (0 = 끔, 기본 0.25)\n"
+            << L"  --readahead-mb N         네트워크 마운트용 앞서 읽기 버퍼(MB, 0 = 끔)\n"
+            << L"  --audio-buffer-ms N      비디오 오디오 PCM 버퍼 상한(ms, 50~5000)\n"
+            << L"  --crossfade N            오디오→오디오 연속 재생 (0 = gapless, N초 크로스페이드)\n"
+            << L"  --native-size            비디오를 창 크기로 축소하지 않고 원본 해상도로 업로드\n"
+            << L"  --huge-pages             변환 프레임 버퍼에 huge page 요청 (Linux)\n"
+            << L"  --convert-in-texture     잠근 텍스처 메모리에 직접 변환\n"
+            << L"  --fast-seek              seek 시 직전 키프레임부터 바로 표시\n\n"
             << L"자막: 미디어 파일과 같은 이름의 .srt/.ass/.ssa 자동 인식\n"
             << L"      내장 자막 스트림(.mkv 등)도 자동 활성화됩니다.\n\n"
             << L"키:  SPACE 일시정지  N/→ 다음  P/← 이전  R 처음\n"
@@ -546,6 +879,8 @@ int main(int argc, char* argv[]) {
         bass::free();
         return 1;
     }
+    // 비디오 오디오 출력 디바이스는 여기서 한 번 열어 종료까지 유지 (파일마다 스트림만 연결)
+    AudioEngine::instance().open();
 
     MediaRenderer mr("MP Media Player",
                      cfg.win_w, cfg.win_h,
@@ -555,13 +890,22 @@ int main(int argc, char* argv[]) {
                      cfg.subtitle_size,
                      "vulkan");
 
+    // 진행바 호버 썸네일 (재생과 별개의 저우선순위 스레드, 0 이하면 끔)
+    std::unique_ptr<Thumbnailer> thumbnailer;
+    if (cfg.thumbnail_cpu > 0.0f) thumbnailer = std::make_unique<Thumbnailer>(cfg.thumbnail_cpu);
+    mr.set_thumbnailer(thumbnailer.get());
+
     size_t                       current_idx    = 0;
     bool                         running        = true;
     bool                         bar_dragging   = false;
     Uint64                       auto_next_tick = 0;
     std::unique_ptr<MediaPlayer> player;
+    Reaper                       reaper;            // 플레이어 해제 (메인 스레드 밖)
+    Prefetcher                   prefetch(reaper);  // 플레이어 열기 / 다음 항목 미리 열기
+    PendingLoad                  pending;
+    Crossfade                    fade;              // 오디오 연속 재생 중 끝나 가는 이전 곡
 
-    load_media(player, playlist[current_idx], cfg, mr, current_idx, playlist.size());
+    load_media(player, pending, prefetch, reaper, playlist, cfg, mr, current_idx);
 
     // ══════════════════ 메인 루프 ══════════════════
     while (running) {
@@ -579,8 +923,8 @@ int main(int argc, char* argv[]) {
             size_t n    = playlist.size();
             current_idx = static_cast<size_t>(
                 (static_cast<long long>(current_idx) + n + advance) % n);
-            load_media(player, playlist[current_idx], cfg, mr,
-                       current_idx, playlist.size());
+            update_crossfade(fade, reaper, true);
+            load_media(player, pending, prefetch, reaper, playlist, cfg, mr, current_idx);
             auto_next_tick = 0;
             bar_dragging   = false;
             continue;
@@ -588,26 +932,29 @@ int main(int argc, char* argv[]) {
 
         // 3. 재로드 (R 키)
         if (reload) {
-            load_media(player, playlist[current_idx], cfg, mr,
-                       current_idx, playlist.size());
+            update_crossfade(fade, reaper, true);
+            load_media(player, pending, prefetch, reaper, playlist, cfg, mr, current_idx);
             auto_next_tick = 0;
             bar_dragging   = false;
             continue;
         }
 
         // 4. 플레이어 tick – 메인 스레드에서 호출
-        //    VideoPlayer : frame_ready_ 확인 → SDL_UpdateTexture
+        //    (백그라운드에서 열던 플레이어가 준비되었으면 먼저 받아서 재생 시작)
+        poll_load(player, pending, prefetch, playlist, cfg, mr);
+        //    VideoPlayer : 클록에 맞는 링 프레임 → SDL_UpdateTexture
         //    ImagePlayer : 프레임 전환, 타이머
         //    AudioPlayer : 종료 감지
         if (player) player->update();
 
-        // 5. 렌더링
+        // 5. 렌더링 (창이 보이지 않으면 생략)
+        const bool visible = window_visible(mr);
         const std::string cur_filename = playlist.size() > current_idx
             ? util::wstring_to_utf8(
                   playlist[current_idx].filename().wstring())
             : std::string{};
 
-        mr.render(player.get(), cur_filename, bar_dragging);
+        if (visible) mr.render(player.get(), cur_filename, bar_dragging);
 
         // bool dirty = false;
         // if (player) dirty = player->update(); // update()가 "화면이 바뀌었는가" 반환
@@ -615,26 +962,36 @@ int main(int argc, char* argv[]) {
         // if (dirty || bar_dragging || mr.is_osd_enabled()) {
         //     mr.render(player.get(), cur_filename, bar_dragging);
         // }
-        // 6. 자동 진행
+        // 6. 자동 진행 (오디오 연속 재생이면 곡 끝 직전에 다음 곡으로 이어 붙임)
+        update_crossfade(fade, reaper);
+        if (try_audio_transition(player, fade, prefetch, reaper, pending, playlist, cfg, mr, current_idx))
+            auto_next_tick = 0;
         if (playlist.size() > 1) {
             if (check_auto_advance(player.get(), cfg, auto_next_tick)) {
                 current_idx = (current_idx + 1) % playlist.size();
-                load_media(player, playlist[current_idx], cfg, mr,
-                           current_idx, playlist.size());
+                update_crossfade(fade, reaper, true);
+                load_media(player, pending, prefetch, reaper, playlist, cfg, mr, current_idx);
                 auto_next_tick = 0;
                 bar_dragging   = false;
             }
         }
 
-        SDL_Delay(8);  // ~120fps 상한, CPU 과점유 방지
+        if (visible) SDL_Delay(8);  // ~120fps 상한, CPU 과점유 방지
+        else         SDL_WaitEventTimeout(nullptr,      // 숨김: 복원 이벤트가 오면 바로 깨어남
+                                          cfg.crossfade >= 0.0f ? 8 : 50);  // 연속 재생은 곡 끝 판정 주기 유지
         // VSync ON이면 SDL_Delay 불필요. 단, 오디오/일시정지 중엔 이벤트 대기로 전환
         // if (!dirty) {
         //     SDL_WaitEventTimeout(nullptr, 8); // 최대 8ms 대기, 이벤트 오면 즉시 처리
         // }        
     }
 
-    // 정리 – player 소멸자가 stop() + join 자동 처리
-    player.reset();
+    // 정리 – player 소멸자(stop() + join)는 Reaper 에서
+    update_crossfade(fade, reaper, true);
+    reaper.retire(std::move(player));
+    prefetch.clear();
+    reaper.drain();    // 남은 해제 작업을 SDL/BASS 종료 전에 모두 처리
+    ProbeCache::instance().flush();   // 열기 경로 밖에서 쓰던 프로브 캐시 기록 마무리
+    AudioEngine::instance().close();
     SDL_Quit();
     bass::free();
 
@@ -8,8 +8,12 @@
 #endif
 
 #include "mediaplayer.h"
+#include "audioengine.h"
 
 #include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
 #include <iostream>
 #include <stdexcept>
 
@@ -17,352 +21,1841 @@
 //  VideoPlayer
 // ════════════════════════════════════════════════════════════════════
 
+/**
+ * @brief FFmpeg 픽셀 포맷 → 업로드 가능한 SDL 텍스처 포맷
+ * @return 대응 포맷이 없으면 SDL_PIXELFORMAT_UNKNOWN
+ */
+static SDL_PixelFormat to_sdl_format(int av_fmt) {
+    switch (av_fmt) {
+    case AV_PIX_FMT_YUV420P:
+    case AV_PIX_FMT_YUVJ420P: return SDL_PIXELFORMAT_IYUV;
+    case AV_PIX_FMT_NV12:     return SDL_PIXELFORMAT_NV12;
+    case AV_PIX_FMT_NV21:     return SDL_PIXELFORMAT_NV21;
+    case AV_PIX_FMT_P010LE:   return SDL_PIXELFORMAT_P010;
+    case AV_PIX_FMT_RGBA:     return SDL_PIXELFORMAT_RGBA32;
+    default:                  return SDL_PIXELFORMAT_UNKNOWN;
+    }
+}
+
+/**
+ * @brief 소스 프레임의 YUV 행렬 결정
+ *
+ *  색 공간 정보가 없으면 소스 해상도로 추정 (HD 이상 BT.709, 그 이하 BT.601).
+ *  축소 출력의 높이로 추정하면 태그 없는 1080p 가 BT.601 로 보여 색이 틀어지므로
+ *  스케일 전에 소스에서 정해 변환 결과에도 그대로 기록한다.
+ */
+static AVColorSpace resolve_colorspace(const AVFrame* src) {
+    switch (src->colorspace) {
+    case AVCOL_SPC_BT709:
+    case AVCOL_SPC_BT2020_NCL:
+    case AVCOL_SPC_BT2020_CL:
+    case AVCOL_SPC_BT470BG:
+    case AVCOL_SPC_SMPTE170M:
+        return src->colorspace;
+    default:
+        if (src->format == AV_PIX_FMT_P010LE) return AVCOL_SPC_BT2020_NCL;
+        return src->height >= 720 ? AVCOL_SPC_BT709 : AVCOL_SPC_SMPTE170M;
+    }
+}
+
+/**
+ * @brief 프레임의 색 공간/범위 → SDL 텍스처 colorspace
+ * @param colorspace resolve_colorspace() 로 정한 행렬
+ */
+static SDL_Colorspace to_sdl_colorspace(int format, AVColorSpace colorspace, AVColorRange range) {
+    if (format == AV_PIX_FMT_RGBA) return SDL_COLORSPACE_SRGB;
+
+    const bool full = range  == AVCOL_RANGE_JPEG ||
+                      format == AV_PIX_FMT_YUVJ420P;
+    switch (colorspace) {
+    case AVCOL_SPC_BT709:
+        return full ? SDL_COLORSPACE_BT709_FULL  : SDL_COLORSPACE_BT709_LIMITED;
+    case AVCOL_SPC_BT2020_NCL:
+    case AVCOL_SPC_BT2020_CL:
+        return full ? SDL_COLORSPACE_BT2020_FULL : SDL_COLORSPACE_BT2020_LIMITED;
+    default:
+        return full ? SDL_COLORSPACE_BT601_FULL  : SDL_COLORSPACE_BT601_LIMITED;
+    }
+}
+
+static SDL_Colorspace to_sdl_colorspace(const AVFrame* frame) {
+    return to_sdl_colorspace(frame->format, resolve_colorspace(frame), frame->color_range);
+}
+
+/**
+ * @brief SDL 오디오 포맷 → 같은 메모리 배치의 FFmpeg interleaved 샘플 포맷
+ * @return 대응 포맷이 없으면 AV_SAMPLE_FMT_NONE
+ */
+static AVSampleFormat to_av_sample_format(SDL_AudioFormat fmt) {
+    switch (fmt) {
+    case SDL_AUDIO_U8:  return AV_SAMPLE_FMT_U8;
+    case SDL_AUDIO_S16: return AV_SAMPLE_FMT_S16;
+    case SDL_AUDIO_S32: return AV_SAMPLE_FMT_S32;
+    case SDL_AUDIO_F32: return AV_SAMPLE_FMT_FLT;
+    default:            return AV_SAMPLE_FMT_NONE;
+    }
+}
+
+/// 코덱별 디코더 스레딩 기본값 (VideoOptions 가 Auto 일 때)
+struct CodecThreadDefault {
+    AVCodecID id;
+    int       max_threads;  ///< 자동 스레드 수 상한 (0 = 코어 수 전부)
+    int       thread_type;  ///< FF_THREAD_FRAME / FF_THREAD_SLICE 조합
+};
+
+static constexpr CodecThreadDefault CODEC_THREAD_DEFAULTS[] = {
+    { AV_CODEC_ID_HEVC,       0,  FF_THREAD_FRAME | FF_THREAD_SLICE },
+    { AV_CODEC_ID_AV1,        0,  FF_THREAD_FRAME                   },
+    { AV_CODEC_ID_VVC,        0,  FF_THREAD_FRAME | FF_THREAD_SLICE },
+    { AV_CODEC_ID_H264,       16, FF_THREAD_FRAME | FF_THREAD_SLICE },
+    { AV_CODEC_ID_VP9,        16, FF_THREAD_FRAME                   },
+    { AV_CODEC_ID_PRORES,     16, FF_THREAD_SLICE                   },
+    { AV_CODEC_ID_MPEG2VIDEO, 8,  FF_THREAD_SLICE                   },
+    { AV_CODEC_ID_MPEG4,      4,  FF_THREAD_FRAME                   },
+};
+
+/// 표에 없는 코덱: FFmpeg 자동 스레드 수 상한과 같게
+static constexpr CodecThreadDefault CODEC_THREAD_FALLBACK = {
+    AV_CODEC_ID_NONE, 16, FF_THREAD_FRAME | FF_THREAD_SLICE
+};
+
+/**
+ * @brief 비디오 디코더 스레딩 설정 (avcodec_open2 이전에 호출)
+ *
+ *  thread_count = 0 (FFmpeg 자동)은 16 스레드로 제한되므로, 코어가 많은 장비에서
+ *  HEVC/AV1 이 코어를 다 쓰도록 직접 계산해서 넣는다.
+ */
+static void configure_decoder_threads(AVCodecContext* ctx, const VideoOptions& opts) {
+    CodecThreadDefault def = CODEC_THREAD_FALLBACK;
+    for (const auto& d : CODEC_THREAD_DEFAULTS)
+        if (d.id == ctx->codec_id) { def = d; break; }
+
+    const int cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    int threads = opts.decoder_threads;
+    if (threads <= 0)
+        threads = def.max_threads > 0 ? std::min(cores, def.max_threads) : cores;
+
+    int type = def.thread_type;
+    switch (opts.decoder_thread_type) {
+    case VideoOptions::ThreadType::Frame: type = FF_THREAD_FRAME;                   break;
+    case VideoOptions::ThreadType::Slice: type = FF_THREAD_SLICE;                   break;
+    case VideoOptions::ThreadType::Both:  type = FF_THREAD_FRAME | FF_THREAD_SLICE; break;
+    case VideoOptions::ThreadType::Auto:                                            break;
+    }
+
+    ctx->thread_count = threads;
+    ctx->thread_type  = type;
+}
+
+/// FF_THREAD_* 조합 → 로그용 문자열
+static const char* thread_type_name(int type) {
+    switch (type & (FF_THREAD_FRAME | FF_THREAD_SLICE)) {
+    case FF_THREAD_FRAME:                   return "frame";
+    case FF_THREAD_SLICE:                   return "slice";
+    case FF_THREAD_FRAME | FF_THREAD_SLICE: return "frame+slice";
+    default:                                return "none";
+    }
+}
+
 /**
  * @brief VideoPlayer 생성자
  * @param filename 비디오 파일 경로 (UTF-8)
  * @param renderer SDL_Renderer
+ * @param opts     디코더 스레딩 설정
  *
- *  FFmpeg 포맷 열기, 스트림 인덱스 찾기, 코덱 열기,
- *  외부/내장 자막 준비, RGBA 변환기 초기화, SDL 텍스처/오디오 스트림 생성.
+ *  FFmpeg 포맷 열기, 스트림 인덱스 찾기, 코덱 열기 (비디오는 스레딩 설정 적용),
+ *  외부/내장 자막 준비, 텍스처 업로드 경로 선택, SDL 오디오 스트림 생성.
+ *  텍스처는 첫 프레임 포맷/크기에 맞춰 update()에서 생성한다.
  */
-VideoPlayer::VideoPlayer(const char* filename, SDL_Renderer* renderer)
-    : renderer_(renderer)
+VideoPlayer::VideoPlayer(const char* filename, SDL_Renderer* renderer,
+                         const VideoOptions& opts)
+    : opts_(opts), renderer_(renderer)
 {
     // ── 포맷 열기 ─────────────────────────────────────────────────
-    if (avformat_open_input(&format_ctx_, filename, nullptr, nullptr) < 0)
-        return;
+    const Uint64 t_open = SDL_GetTicksNS();
+
+    // 앞서 읽기: 디먹서는 I/O 스레드가 채운 링 버퍼에서만 읽는다 (실패하면 기본 I/O)
+    if (opts_.readahead_mb > 0)
+        readahead_ = ReadAhead::open(filename, static_cast<size_t>(opts_.readahead_mb) * 1024 * 1024);
+
+    // fast = 프로브 캐시 적중: 작은 한도로 프로브하고 모자란 값은 캐시로 채운다
+    auto open_format = [&](bool fast) {
+        if (readahead_) {
+            avio_seek(readahead_->avio(), 0, SEEK_SET);
+            if (!(format_ctx_ = avformat_alloc_context())) return false;
+            format_ctx_->pb     = readahead_->avio();
+            format_ctx_->flags |= AVFMT_FLAG_CUSTOM_IO;
+        }
+        AVDictionary* fopts = nullptr;
+        if (fast) {
+            av_dict_set_int(&fopts, "probesize",       ProbeCache::HIT_PROBE_SIZE, 0);
+            av_dict_set_int(&fopts, "analyzeduration", ProbeCache::HIT_ANALYZE_US, 0);
+        }
+        const int ret = avformat_open_input(&format_ctx_, filename, nullptr, &fopts);
+        av_dict_free(&fopts);
+        if (ret < 0) return false;
+        avformat_find_stream_info(format_ctx_, nullptr);
+        return true;
+    };
 
-    avformat_find_stream_info(format_ctx_, nullptr);
+    ProbeCache& probe_cache = ProbeCache::instance();
+    ProbeInfo   cached;
+    bool        probe_hit   = probe_cache.lookup(filename, cached);
+    if (!open_format(probe_hit)) return;
+    if (probe_hit && !ProbeCache::apply(format_ctx_, cached)) {
+        // 짧은 프로브로는 스트림 구성이 다르게 보임 – 기본 한도로 다시
+        std::cout << "[프로브] 캐시와 스트림 구성이 달라 다시 프로브\n";
+        probe_cache.reject(filename);
+        avformat_close_input(&format_ctx_);
+        probe_hit = false;
+        if (!open_format(false)) return;
+    }
     raw_duration_ = static_cast<double>(format_ctx_->duration);
 
     // ── 코덱 초기화 헬퍼 ─────────────────────────────────────────
+    // known: 캐시에 저장된 선택 스트림 (같은 종류면 best-stream 탐색 생략)
     auto open_codec = [&](AVMediaType type, AVCodecContext*& ctx,
-                          int& idx, int prefer = -1) {
+                          int& idx, int prefer = -1, int known = -1) {
         const AVCodec* codec = nullptr;
-        idx = av_find_best_stream(format_ctx_, type, -1, prefer, &codec, 0);
+        if (known >= 0 && known < static_cast<int>(format_ctx_->nb_streams) &&
+            format_ctx_->streams[known]->codecpar->codec_type == type &&
+            (codec = avcodec_find_decoder(format_ctx_->streams[known]->codecpar->codec_id)))
+            idx = known;
+        else
+            idx = av_find_best_stream(format_ctx_, type, -1, prefer, &codec, 0);
         if (idx < 0) return;
         ctx = avcodec_alloc_context3(codec);
         avcodec_parameters_to_context(ctx, format_ctx_->streams[idx]->codecpar);
+        if (type == AVMEDIA_TYPE_VIDEO) configure_decoder_threads(ctx, opts);
         avcodec_open2(ctx, codec, nullptr);
     };
 
-    open_codec(AVMEDIA_TYPE_VIDEO, video_ctx_,    video_stream_idx_);
-    open_codec(AVMEDIA_TYPE_AUDIO, audio_ctx_,    audio_stream_idx_, video_stream_idx_);
+    const int known_v = probe_hit ? cached.video_idx : -1;
+    const int known_a = probe_hit ? cached.audio_idx : -1;
+    open_codec(AVMEDIA_TYPE_VIDEO, video_ctx_,    video_stream_idx_, -1, known_v);
+    open_codec(AVMEDIA_TYPE_AUDIO, audio_ctx_,    audio_stream_idx_, video_stream_idx_, known_a);
+
+    if (!video_ctx_) return;
+
+    // 요청 값과 코덱이 실제로 활성화한 방식이 다를 수 있음 (예: 슬라이스 미지원 스트림)
+    std::cout << "[비디오] 디코더: " << avcodec_get_name(video_ctx_->codec_id)
+              << ", 스레드 " << video_ctx_->thread_count
+              << " (요청 " << thread_type_name(video_ctx_->thread_type)
+              << ", 활성 " << thread_type_name(video_ctx_->active_thread_type) << ")\n";
+
+    video_stream_ = format_ctx_->streams[video_stream_idx_];
+
+    const AVRational fr = av_guess_frame_rate(format_ctx_, video_stream_, nullptr);
+    if (fr.num > 0 && fr.den > 0) frame_duration_ = 1.0 / av_q2d(fr);
+
+    // ── 자막 스트림 ──────────────────────────────────────────────
+    // 외부 파일 우선, 없으면 FFmpeg 내장 자막 스트림 열기
+    {
+        std::filesystem::path mpath(filename);
+        bool external_loaded;
+        {
+            std::lock_guard<std::mutex> lk(subtitle_mutex_);
+            external_loaded = subtitle_track_.load_file(mpath);
+        }
+
+        if (external_loaded) {
+            std::wcout << L"[자막] 외부 파일 로드: "
+                       << mpath.stem().wstring() << L"\n";
+            use_embedded_sub_ = false;
+        } else {
+            // FFmpeg 내장 자막 스트림 탐색
+            open_codec(AVMEDIA_TYPE_SUBTITLE, subtitle_ctx_, subtitle_stream_idx_, -1,
+                       probe_hit ? cached.subtitle_idx : -1);
+            if (subtitle_stream_idx_ >= 0) {
+                use_embedded_sub_ = true;
+                std::cout << "[자막] 내장 스트림 #"
+                          << subtitle_stream_idx_ << " 활성화\n";
+            }
+        }
+    }
+
+    // ── 프로브 캐시 갱신 + 열기 지연 ─────────────────────────────
+    if (!probe_hit || cached.video_idx != video_stream_idx_ ||
+        cached.audio_idx != audio_stream_idx_ || cached.subtitle_idx != subtitle_stream_idx_) {
+        ProbeInfo info    = ProbeCache::capture(format_ctx_);
+        info.video_idx    = video_stream_idx_;
+        info.audio_idx    = audio_stream_idx_;
+        info.subtitle_idx = subtitle_stream_idx_;
+        probe_cache.store(filename, info);
+    }
+    {
+        const ProbeCache::Stats ps = probe_cache.stats();
+        std::cout << "[프로브] " << (probe_hit ? "캐시 적중" : "캐시 미스") << ", 열기 "
+                  << (SDL_GetTicksNS() - t_open) / SDL_NS_PER_MS << "ms (누적 적중 "
+                  << ps.hits << " / 미스 " << ps.misses << ")\n";
+    }
+
+    // ── 텍스처 업로드 경로 선택 ──────────────────────────────────
+    // 렌더러가 지원하는 포맷 목록 (SDL_PIXELFORMAT_UNKNOWN 으로 끝나는 배열)
+    if (const auto* fmts = static_cast<const SDL_PixelFormat*>(
+            SDL_GetPointerProperty(SDL_GetRendererProperties(renderer_),
+                                   SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER,
+                                   nullptr)))
+    {
+        for (; *fmts != SDL_PIXELFORMAT_UNKNOWN; ++fmts)
+            texture_formats_.push_back(*fmts);
+    }
+
+    direct_ = supports_texture_format(to_sdl_format(video_ctx_->pix_fmt));
+
+    frame_pool_.set_huge_pages(opts_.huge_pages);
+    if (!direct_) {
+        // 폴백: RGBA 변환 버퍼를 링 슬롯 수 + 1(변환 중) 만큼 미리 할당
+        // (텍스처 직접 변환이면 변환 버퍼가 필요 없음). 출력 크기로 축소하면 변환 크기는
+        // 첫 프레임에서야 정해지므로 그때 convert_frame() 이 그 크기로 채운다.
+        if (!opts_.convert_in_texture && !opts_.scale_to_output &&
+            !frame_pool_.reserve(frames_.capacity() + 1, video_ctx_->width,
+                                 video_ctx_->height, AV_PIX_FMT_RGBA))
+            return;
+
+        init_sws(video_ctx_->width, video_ctx_->height, video_ctx_->pix_fmt,
+                 video_ctx_->width, video_ctx_->height, AV_PIX_FMT_RGBA);
+    }
+
+    std::cout << "[비디오] 텍스처 경로: "
+              << (direct_                  ? "직접 업로드 ("
+                  : opts_.convert_in_texture ? "sws_scale → 잠근 텍스처 ("
+                                             : "sws_scale → RGBA (")
+              << (av_get_pix_fmt_name(video_ctx_->pix_fmt)
+                      ? av_get_pix_fmt_name(video_ctx_->pix_fmt) : "?")
+              << ")\n";
+
+    // ── 오디오 출력 (공유 AudioEngine 디바이스에 스트림 연결) ──────
+    // 디바이스 고유 포맷/레이트/채널로 변환은 오디오 스레드의 swresample 이 맡는다
+    // (SDL 콜백 스레드에서 리샘플하지 않도록). 디바이스 포맷을 못 쓰면 F32 로 넣고 SDL 이 변환.
+    // 디바이스가 데이터를 요청할 때 get 콜백이 pcm_ 에서 꺼내 간다 (풀 방식).
+    SDL_AudioSpec spec{};
+    if (audio_ctx_ && AudioEngine::instance().output_format(spec, device_latency_)) {
+        out_fmt_ = to_av_sample_format(spec.format);
+        if (out_fmt_ == AV_SAMPLE_FMT_NONE) {
+            spec.format = SDL_AUDIO_F32;
+            out_fmt_    = AV_SAMPLE_FMT_FLT;
+        }
+        out_rate_        = spec.freq;
+        out_frame_bytes_ = SDL_AUDIO_FRAMESIZE(spec);
+        av_channel_layout_default(&out_layout_, spec.channels);
+
+        // 콜백이 연결 직후부터 불릴 수 있으므로 링을 먼저 준비 (크기는 샘플 프레임 단위로 맞춤)
+        const double bps   = static_cast<double>(spec.freq) * out_frame_bytes_;
+        const auto   frame = static_cast<size_t>(out_frame_bytes_);
+        audio_high_water_  = static_cast<size_t>(bps * opts_.audio_buffer_ms / 1000.0) / frame * frame;
+        pcm_.reset(audio_high_water_ + static_cast<size_t>(bps * AUDIO_RING_EXTRA_SEC) / frame * frame);
+        audio_bytes_per_sec_ = bps;
+
+        audio_stream_ = AudioEngine::instance().attach(spec, &VideoPlayer::audio_callback, this);
+        if (audio_stream_) {
+            audio_buf_.reserve(static_cast<size_t>(audio_bytes_per_sec_ * AUDIO_BATCH_SEC) * 2);
+            std::cout << "[비디오] 오디오 출력: " << spec.channels << "ch " << spec.freq << "Hz "
+                      << av_get_sample_fmt_name(out_fmt_) << " (입력 "
+                      << audio_ctx_->ch_layout.nb_channels << "ch " << audio_ctx_->sample_rate << "Hz "
+                      << (av_get_sample_fmt_name(audio_ctx_->sample_fmt)
+                              ? av_get_sample_fmt_name(audio_ctx_->sample_fmt) : "?")
+                      << "), 버퍼 " << opts_.audio_buffer_ms << "ms\n";
+            SDL_SetAudioStreamGain(audio_stream_, volume_.load());
+        } else {
+            audio_bytes_per_sec_ = 0.0;
+        }
+    }
+
+    // ── 쓰지 않는 스트림은 디먹서에서 버림 (오디오 출력/외부 자막 여부까지 정해진 뒤) ──
+    update_stream_discard();
+
+    // ── 키프레임 인덱스 (긴 파일만, 재생 중 백그라운드 빌드) ────────
+    // 빌드는 실제로 재생이 시작될 때 (play()/일시정지 해제) – 미리 열어 둔 다음 항목은
+    // 현재 파일을 재생하는 동안 전체 스캔을 시작하지 않는다.
+    // TS 계열은 타임스탬프 seek 가 파일 이분 탐색이므로 바이트 오프셋으로 바로 이동,
+    // 그 외(MKV 등)는 디먹서 인덱스에 항목을 주입해 av_seek_frame 이 쓰게 한다.
+    const double length = get_length();
+    if (length <= 0.0 || length >= KEYFRAME_INDEX_MIN_SEC) {
+        kf_index_  = KeyframeIndex::acquire(filename);
+        byte_seek_ = (format_ctx_->iformat->flags & AVFMT_TS_DISCONT) &&
+                    !(format_ctx_->iformat->flags & AVFMT_NO_BYTE_SEEK);
+    }
+}
+
+/**
+ * @brief VideoPlayer 리소스 정리 (소멸자 및 재초기화 시 사용)
+ */
+void VideoPlayer::cleanup() {
+    if (converted_frames_.load() > 0) {
+        std::cout << "[비디오] 변환 " << converted_frames_.load() << " 프레임, 평균 "
+                  << convert_ms_total_ / static_cast<double>(converted_frames_.load())
+                  << "ms (sws 스레드 " << opts_.sws_threads << ", 0 = 자동)\n";
+    }
+    if (uploaded_frames_ > 0) {
+        std::cout << "[비디오] 업로드 " << uploaded_frames_ << " 프레임, 평균 "
+                  << upload_ms_total_ / static_cast<double>(uploaded_frames_) << "ms"
+                  << (opts_.convert_in_texture ? " (변환 포함, 텍스처 직접 변환)\n" : "\n");
+    }
+    av_frame_free(&lock_frame_);
+    if (audio_underruns_.load() > 0 && audio_bytes_per_sec_ > 0.0)
+        std::cout << "[비디오] 오디오 언더런 " << audio_underruns_.load() << "회 (무음 "
+                  << static_cast<int>(static_cast<double>(underrun_bytes_.load()) / audio_bytes_per_sec_ * 1000.0)
+                  << "ms)\n";
+    if (seek_count_ > 0)
+        std::cout << "[비디오] seek " << seek_count_ << "회, 첫 프레임까지 평균 "
+                  << seek_ms_total_ / static_cast<double>(seek_count_) << "ms\n";
+    if (discarded_streams_ > 0 && discarded_bps_ > 0)
+        std::cout << "[비디오] 버린 스트림 " << discarded_streams_ << "개, 약 "
+                  << static_cast<int>(discarded_mb() + 0.5) << "MB 읽기/파싱 생략 (추정)\n";
+    const PoolStats vp = video_q_.pool_stats(), ap = audio_q_.pool_stats(), fp = frame_pool_.stats();
+    if (vp.allocs + ap.allocs + fp.allocs > 0)
+        std::cout << "[비디오] 풀 할당/재사용: 패킷 " << vp.allocs + ap.allocs << "/" << vp.reuses + ap.reuses
+                  << ", 프레임 버퍼 " << fp.allocs << "/" << fp.reuses << "\n";
+    if (sws_ctx_)             { sws_freeContext(sws_ctx_);            sws_ctx_  = nullptr; }
+    if (swr_)                 { swr_free(&swr_);                                           }
+    av_channel_layout_uninit(&swr_in_layout_);
+    av_channel_layout_uninit(&out_layout_);
+    if (subtitle_ctx_)        { avcodec_free_context(&subtitle_ctx_);                      }
+    if (video_ctx_)           { avcodec_free_context(&video_ctx_);                         }
+    if (audio_ctx_)           { avcodec_free_context(&audio_ctx_);                         }
+    if (format_ctx_)          { avformat_close_input(&format_ctx_);                        }
+    readahead_.reset();   // CUSTOM_IO 이므로 pb 는 close_input 이 닫지 않음
+    AudioEngine::instance().detach(audio_stream_);   // 디바이스는 닫지 않음
+    if (texture_)             { SDL_DestroyTexture(texture_);         texture_  = nullptr; }
+}
+
+/**
+ * @brief 텍스처만 먼저 해제 (디코딩 스레드는 텍스처를 건드리지 않으므로 정지 없이 가능)
+ */
+void VideoPlayer::release_textures() {
+    if (texture_) { SDL_DestroyTexture(texture_); texture_ = nullptr; }
+}
+
+/**
+ * @brief 전체 재생 길이 반환 (초)
+ */
+double VideoPlayer::get_length() const {
+    return raw_duration_ / static_cast<double>(AV_TIME_BASE);
+}
+
+/**
+ * @brief 볼륨 설정 (0.0~1.0)
+ */
+void VideoPlayer::set_volume(float v) {
+    volume_ = SDL_clamp(v, 0.0f, 1.0f);
+    if (audio_stream_)
+        SDL_SetAudioStreamGain(audio_stream_, volume_.load());
+}
+
+/**
+ * @brief 현재 시간에 해당하는 자막 텍스트 반환
+ */
+std::string VideoPlayer::get_subtitle_text() const {
+    std::lock_guard<std::mutex> lk(subtitle_mutex_);
+    return subtitle_track_.get_active(cur_pts_.load());
+}
+
+/**
+ * @brief OSD 진단 줄: A/V 오차(ms)와 드롭/반복 프레임 수
+ */
+std::string VideoPlayer::get_debug_info() const {
+    const auto ms = [](double sec) {
+        const int v = static_cast<int>(sec * 1000.0 + (sec < 0 ? -0.5 : 0.5));
+        return (v > 0 ? "+" : "") + std::to_string(v);
+    };
+    return "A-V: " + ms(sync_stats_.drift) + "ms"
+         + " (평균 " + ms(sync_stats_.drift_avg)
+         + " / 최대 " + ms(sync_stats_.drift_max) + ")"
+         + "  드롭 " + std::to_string(sync_stats_.dropped)
+         + "  반복 " + std::to_string(sync_stats_.repeated)
+         + "  스킵 " + std::to_string(skip_counts_[1].load())
+         + "/" + std::to_string(skip_counts_[2].load())
+         + "/" + std::to_string(skip_counts_[3].load())
+         + (converted_frames_.load() > 0
+                ? "  변환 " + std::to_string(convert_ms_avg_.load()).substr(0, 4) + "ms"
+                : std::string{})
+         // 풀 새 할당 수 (패킷 껍데기/큐 링/변환 버퍼만 – 패킷 데이터는 디먹서가 매번 할당)
+         + "  풀 할당 " + std::to_string(video_q_.pool_stats().allocs + audio_q_.pool_stats().allocs
+                                      + frame_pool_.stats().allocs)
+         + (discarded_streams_ > 0
+                ? "  버림 " + std::to_string(discarded_streams_)
+                  + (discarded_bps_ > 0 ? " ~" + std::to_string(discarded_mb()).substr(0, 5) + "MB"
+                                        : std::string{})
+                : std::string{})
+         + (seek_count_ > 0
+                ? "  seek " + std::to_string(static_cast<int>(seek_ms_last_)) + "ms (평균 "
+                  + std::to_string(static_cast<int>(seek_ms_total_ / static_cast<double>(seek_count_))) + ")"
+                : std::string{})
+         + (audio_bytes_per_sec_ > 0.0
+                ? "  오디오 " + std::to_string(static_cast<int>(static_cast<double>(pcm_.size())
+                                                              / audio_bytes_per_sec_ * 1000.0))
+                  + "/" + std::to_string(opts_.audio_buffer_ms) + "ms 언더런 "
+                  + std::to_string(audio_underruns_.load())
+                : std::string{})
+         + readahead_info();
+}
+
+/**
+ * @brief 선택된 비디오/오디오/자막 외 스트림을 AVDISCARD_ALL 로 표시
+ *
+ *  버린 스트림의 패킷은 디먹서가 파싱/조립하지 않고 건너뛴다 (MKV 는 블록 건너뛰기,
+ *  TS 는 PES 조립 생략). 선택이 바뀌면 다시 호출한다 – 디먹스 스레드가 av_read_frame
+ *  안에서 읽는 값이므로 play() 전이나 디먹스 스레드에서만 호출한다.
+ *  절약량 추정을 위해 버린 스트림의 비트레이트 합을 기억한다 (codecpar 에 없으면
+ *  mkvmerge 통계 태그 BPS 사용, 둘 다 없으면 추정에서 제외).
+ */
+void VideoPlayer::update_stream_discard() {
+    const bool use_audio = audio_ctx_ && audio_stream_;
+    const bool use_sub   = use_embedded_sub_ && subtitle_ctx_;
+
+    discarded_streams_ = 0;
+    discarded_bps_     = 0;
+    std::string names;
+    for (unsigned i = 0; i < format_ctx_->nb_streams; ++i) {
+        AVStream* st   = format_ctx_->streams[i];
+        const int idx  = static_cast<int>(i);
+        const bool used = idx == video_stream_idx_ ||
+                          (use_audio && idx == audio_stream_idx_) ||
+                          (use_sub   && idx == subtitle_stream_idx_);
+        st->discard = used ? AVDISCARD_DEFAULT : AVDISCARD_ALL;
+        if (used) continue;
+
+        ++discarded_streams_;
+        int64_t bps = st->codecpar->bit_rate;
+        if (bps <= 0) {
+            const AVDictionaryEntry* tag = av_dict_get(st->metadata, "BPS", nullptr, 0);
+            if (!tag) tag = av_dict_get(st->metadata, "BPS-eng", nullptr, 0);
+            if (tag) bps = std::strtoll(tag->value, nullptr, 10);
+        }
+        if (bps > 0) discarded_bps_ += bps;
+
+        const char* type = av_get_media_type_string(st->codecpar->codec_type);
+        names += " #" + std::to_string(idx) + " " + (type ? type : "?") + "/"
+               + avcodec_get_name(st->codecpar->codec_id);
+    }
+
+    if (discarded_streams_ > 0)
+        std::cout << "[비디오] 스트림 " << format_ctx_->nb_streams << "개 중 "
+                  << discarded_streams_ << "개 버림:" << names << "\n";
+}
+
+/**
+ * @brief 버린 스트림으로 아낀 바이트 추정치 (비트레이트 × 디먹스한 비디오 길이)
+ */
+double VideoPlayer::discarded_mb() const {
+    return static_cast<double>(discarded_bps_) / 8.0
+         * (static_cast<double>(demuxed_us_.load()) / 1e6) / (1024.0 * 1024.0);
+}
+
+/**
+ * @brief 앞서 읽기 버퍼 채움 정도 (OSD 용, 끔이면 빈 문자열)
+ */
+std::string VideoPlayer::readahead_info() const {
+    if (!readahead_) return {};
+    const ReadAhead::Stats st = readahead_->stats();
+    const int pct = st.capacity > 0 ? static_cast<int>(st.buffered * 100 / st.capacity) : 0;
+    return "  버퍼 " + std::to_string(pct) + "% "
+         + std::to_string(st.buffered / (1024 * 1024)) + "MB"
+         + (st.eof ? " (끝)" : st.failed ? " (읽기 실패)" : "")
+         + (st.stalls > 0 ? " 대기 " + std::to_string(st.stalls) : std::string{})
+         + (st.errors > 0 ? " 오류 " + std::to_string(st.errors) : std::string{});
+}
+
+/**
+ * @brief 패킷 큐 + 표시 대기 프레임 + PCM 링 + 앞서 읽기 버퍼 (프레임은 디코더 출력 크기로 추정)
+ */
+size_t VideoPlayer::buffered_bytes() const {
+    size_t bytes = video_q_.bytes() + audio_q_.bytes() + pcm_.capacity();
+    if (video_ctx_) {
+        const int frame = av_image_get_buffer_size(video_ctx_->pix_fmt, video_ctx_->width,
+                                                   video_ctx_->height, 1);
+        if (frame > 0) bytes += static_cast<size_t>(frame) * static_cast<size_t>(frames_.size());
+    }
+    if (readahead_) bytes += readahead_->stats().capacity;
+    return bytes;
+}
+
+// ── play / stop ───────────────────────────────────────────────────
+
+/**
+ * @brief 디먹스/비디오/오디오 스레드 시작
+ */
+void VideoPlayer::play() {
+    if (running_.load()) return;
+    running_ = true;
+    ended_   = false;
+
+    video_q_.start();
+    audio_q_.start();
+    frames_.start();
+    set_clock(cur_pts_.load());
+
+    demux_thread_ = std::thread(&VideoPlayer::demux_loop, this);
+    video_thread_ = std::thread(&VideoPlayer::video_decode_loop, this);
+    if (audio_ctx_ && audio_stream_)
+        audio_thread_ = std::thread(&VideoPlayer::audio_decode_loop, this);
+
+    if (kf_index_ && !paused_.load()) kf_index_->start();   // 미리 열기(일시정지 상태)면 재개 시
+}
+
+/**
+ * @brief 파이프라인 스레드 중지 및 대기
+ *
+ *  큐를 abort 하여 pop()에서 블로킹 중인 디코더 스레드를 깨우고,
+ *  wait_event() 중인 디먹스/오디오 스레드도 바로 깨운다. 소요 시간은 로그로 남긴다
+ *  (플레이어 전환 지연의 대부분).
+ */
+void VideoPlayer::stop() {
+    const bool   was_running = demux_thread_.joinable();
+    const Uint64 t0          = SDL_GetTicksNS();
+
+    running_ = false;
+    wake_workers();
+    if (readahead_) readahead_->abort();   // 버퍼를 기다리는 av_read_frame 깨우기
+    video_q_.abort();
+    audio_q_.abort();
+    frames_.abort();
+
+    if (demux_thread_.joinable()) demux_thread_.join();
+    if (video_thread_.joinable()) video_thread_.join();
+    if (audio_thread_.joinable()) audio_thread_.join();
+
+    if (was_running)
+        std::cout << "[비디오] 정지 " << (SDL_GetTicksNS() - t0) / SDL_NS_PER_MS << "ms\n";
+}
+
+/**
+ * @brief wait_event() 중인 스레드 깨우기
+ *
+ *  상태(atomic)를 바꾼 뒤 호출한다. 대기 쪽은 상태를 확인하기 전에 wake_seq_ 를
+ *  읽어 두므로, 확인과 대기 사이에 일어난 이벤트도 놓치지 않는다.
+ */
+void VideoPlayer::wake_workers() {
+    {
+        std::lock_guard<std::mutex> lk(wake_mutex_);
+        ++wake_seq_;
+    }
+    wake_cv_.notify_all();
+}
+
+void VideoPlayer::wait_event(uint32_t seq, Uint64 timeout_ns) {
+    std::unique_lock<std::mutex> lk(wake_mutex_);
+    auto woken = [&] { return wake_seq_.load() != seq; };
+    if (timeout_ns == 0) wake_cv_.wait(lk, woken);
+    else                 wake_cv_.wait_for(lk, std::chrono::nanoseconds(timeout_ns), woken);
+}
+
+/**
+ * @brief 일시정지 토글
+ *
+ *  클록을 고정/재개한다. 공유 디바이스는 멈추지 않고, 일시정지 중에는 get 콜백이
+ *  pcm_ 을 꺼내 가지 않아 이 스트림만 무음이 된다 (링에 남은 샘플은 재개 시 이어서 재생).
+ */
+void VideoPlayer::toggle_pause() {
+    {
+        std::lock_guard<std::mutex> lk(clock_mutex_);
+        const int64_t now = static_cast<int64_t>(SDL_GetTicksNS());
+        if (!paused_.load()) {
+            if (!seek_hold_.load())   // seek 대기 중이면 클록은 이미 목표에 고정
+                pause_clock_ = static_cast<double>(now - clock_base_ns_) / SDL_NS_PER_SECOND;
+            paused_      = true;
+        } else {
+            clock_base_ns_ = now - static_cast<int64_t>(pause_clock_ * SDL_NS_PER_SECOND);
+            paused_        = false;
+        }
+    }
+    if (kf_index_ && !paused_.load() && running_.load()) kf_index_->start();
+    wake_workers();
+}
+
+/**
+ * @brief 지정 시간으로 탐색 요청
+ *
+ *  실제 av_seek_frame 은 디먹스 스레드가 수행한다. 여기서는 세대(serial_)를
+ *  올려 링에 남은 이전 프레임이 즉시 폐기되도록 하고 클록을 목표 시간으로 맞춘다.
+ *  scrub 모드였다면 여기서 끝나고, 이 seek 는 정확한 위치까지 디코딩한다
+ *  (accurate_seek 이면 선행 구간은 디코딩만 하고 변환/업로드 없이 버림).
+ *
+ *  첫 프레임이 나올 때까지 클록과 오디오 출력을 목표 시간에 멈춰 두므로(seek_hold_)
+ *  선행 구간을 디코딩하는 동안 클록이 앞서 나가 이후 프레임이 늦은 것으로 버려지지 않고,
+ *  첫 프레임은 도착 즉시 표시된다 (update() → release_seek_hold()).
+ */
+void VideoPlayer::seek(double secs) {
+    secs = std::max(0.0, secs);
+    scrubbing_    = false;
+    scrub_target_ = -1.0;
+    seek_req_ns_  = SDL_GetTicksNS();
+    set_clock(secs);
+    seek_hold_    = true;   // 새 세대 프레임이 판정되기 전에 클록 고정
+    ++serial_;
+    cur_pts_     = secs;
+    seek_target_ = secs;
+    ended_       = false;
+    wake_workers();
+}
+
+/**
+ * @brief 미리보기 탐색 (진행바 드래그 중)
+ *
+ *  목표만 기록하고 반환한다. 디먹스 스레드가 최신 목표로 합쳐 키프레임만 디코딩하여
+ *  보여 주며, 세대(serial_)도 그 시점에 올린다 – 여기서 올리면 빠른 드래그 중에
+ *  진행 중인 scrub 프레임이 매번 폐기되어 아무것도 표시되지 않는다.
+ *  드래그를 끝낼 때 seek() 를 호출하면 정확한 위치로 한 번 더 탐색한다.
+ */
+void VideoPlayer::scrub(double secs) {
+    secs          = std::max(0.0, secs);
+    scrub_target_ = secs;
+    cur_pts_      = secs;   // 진행바가 드래그를 바로 따라가도록
+    ended_        = false;
+    scrubbing_    = true;
+    wake_workers();
+}
+
+/**
+ * @brief 창 표시 상태 변경 (메인 스레드)
+ *
+ *  숨김: 디코딩 스레드가 비디오 패킷을 디코더에 넣지 않고 버리므로 디코딩/변환/업로드가
+ *  모두 멈춘다. 오디오와 재생 클록은 그대로 진행한다.
+ *  복원: 참조 프레임이 끊겼으므로 현재 클록 위치로 seek 한 번 하여 화면을 다시 맞춘다.
+ *  seek() 가 serial_ 을 먼저 올리므로 그 사이 디코딩된 이전 세대 프레임은 표시되지 않는다.
+ */
+void VideoPlayer::set_visible(bool visible) {
+    if (visible != hidden_.load()) return;
+
+    if (!visible) {
+        hidden_since_ns_ = SDL_GetTicksNS();
+        hidden_          = true;
+        std::cout << "[비디오] 창 숨김 – 비디오 디코딩 중지 (오디오 계속)\n";
+        return;
+    }
+
+    const double pos = clock_now();
+    seek(pos);
+    hidden_ = false;
+    std::cout << "[비디오] 창 복원 – 숨김 " << (SDL_GetTicksNS() - hidden_since_ns_) / SDL_NS_PER_MS
+              << "ms 동안 패킷 " << hidden_skipped_.exchange(0) << "개 건너뜀, "
+              << pos << "s 로 다시 맞춤\n";
+}
+
+// ── 재생 클록 ────────────────────────────────────────────────────
+
+/**
+ * @brief 현재 재생 클록 (초)
+ */
+double VideoPlayer::clock_now() const {
+    std::lock_guard<std::mutex> lk(clock_mutex_);
+    if (paused_.load() || seek_hold_.load()) return pause_clock_;
+    const int64_t now = static_cast<int64_t>(SDL_GetTicksNS());
+    return static_cast<double>(now - clock_base_ns_) / SDL_NS_PER_SECOND;
+}
+
+/**
+ * @brief 재생 클록을 pts 로 재설정 (일시정지 중이면 고정 값도 갱신)
+ */
+void VideoPlayer::set_clock(double pts) {
+    std::lock_guard<std::mutex> lk(clock_mutex_);
+    clock_base_ns_ = static_cast<int64_t>(SDL_GetTicksNS())
+                   - static_cast<int64_t>(pts * SDL_NS_PER_SECOND);
+    pause_clock_   = pts;
+}
+
+/**
+ * @brief 실제로 재생된 오디오 위치 (초)
+ * @param serial 현재 seek 세대
+ * @return 오디오 클록, 현재 세대 오디오가 없거나 다 재생되었으면 -1
+ *
+ *  audio_end_pts_ 와 pcm_ 잔량을 같은 락 아래에서 읽어야 기록 직후의 불일치가 없다.
+ *  (콜백은 락 없이 읽기만 하므로 잔량은 줄어들 뿐 – 클록이 앞서 보일 일은 없다)
+ */
+double VideoPlayer::audio_clock(int serial) const {
+    if (!audio_stream_ || audio_bytes_per_sec_ <= 0.0) return -1.0;
+
+    std::lock_guard<std::mutex> lk(clock_mutex_);
+    if (audio_serial_ != serial || audio_end_pts_ < 0.0) return -1.0;
+
+    const size_t queued = pcm_.size()
+                        + static_cast<size_t>(std::max(SDL_GetAudioStreamQueued(audio_stream_), 0));
+    if (queued == 0) return -1.0;   // 언더런 / 오디오 종료 → 벽시계로 진행
+
+    return audio_end_pts_
+         - static_cast<double>(queued) / audio_bytes_per_sec_
+         - device_latency_;
+}
+
+/**
+ * @brief 표시 클록을 오디오 클록 쪽으로 보정하고 오차 통계 갱신
+ *
+ *  - |오차| ≤ AV_SYNC_THRESHOLD : 그대로 둠
+ *  - |오차| ≥ AV_RESYNC_SEC      : 즉시 맞춤 (seek 직후, 디바이스 전환 등)
+ *  - 그 사이                     : AV_SYNC_SLEW 비율만큼 당김
+ *  slew 로 클록을 뒤로 당긴 만큼 현재 프레임이 더 오래 유지되므로 반복 프레임으로 센다.
+ */
+void VideoPlayer::sync_to_audio(int serial) {
+    if (paused_.load() || seek_hold_.load()) return;
+
+    const double ac = audio_clock(serial);
+    if (ac < 0.0) return;
+
+    double correction = 0.0;
+    bool   resync     = false;
+    {
+        std::lock_guard<std::mutex> lk(clock_mutex_);
+        const int64_t now   = static_cast<int64_t>(SDL_GetTicksNS());
+        const double  wall  = static_cast<double>(now - clock_base_ns_) / SDL_NS_PER_SECOND;
+        const double  drift = ac - wall;
+
+        sync_stats_.drift = drift;
+        if (std::abs(drift) >= AV_RESYNC_SEC) {
+            // seek 직후 등 불연속 – 평균/최대 통계에서 제외
+            correction = drift;
+            resync     = true;
+            ++sync_stats_.resyncs;
+        } else {
+            sync_stats_.drift_avg = sync_stats_.drift_avg * 0.99 + drift * 0.01;
+            sync_stats_.drift_max = std::max(sync_stats_.drift_max, std::abs(drift));
+            if (std::abs(drift) > AV_SYNC_THRESHOLD)
+                correction = drift * AV_SYNC_SLEW;
+        }
+        clock_base_ns_ -= static_cast<int64_t>(correction * SDL_NS_PER_SECOND);
+    }
+
+    if (!resync && correction < 0.0) {
+        repeat_accum_ -= correction;
+        while (repeat_accum_ >= frame_duration_) {
+            repeat_accum_ -= frame_duration_;
+            ++sync_stats_.repeated;
+        }
+    }
+}
+
+// ── 메인 스레드: update() ────────────────────────────────────────
+
+/**
+ * @brief 메인 루프에서 매 프레임 호출, 클록에 맞는 프레임을 텍스처로 업로드
+ *
+ *  - 표시 클록을 오디오 클록에 맞춰 보정 (sync_to_audio)
+ *  - 이전 seek 세대의 프레임은 폐기
+ *  - 표시 시각이 지난 프레임이 여러 개면 가장 최근 것만 업로드 (늦은 프레임 드롭)
+ *  - 아직 표시 시각이 안 된 프레임은 링에 남겨 둔다 (현재 프레임 반복)
+ *  - 디코더가 EOF 까지 드레인했고 링이 비면 ended_ 설정
+ *  - 창이 보이지 않으면(hidden_) 업로드 없이 링만 비움
+ *
+ * @return false면 재생 종료 (ended_)
+ */
+bool VideoPlayer::update() {
+    const int serial = serial_.load();
+    sync_to_audio(serial);
+    const double clock = clock_now();
+
+    // seek 후 프레임이 끝내 나오지 않으면 (파일 끝 너머 등) 목표 시간에서 클록 재개
+    bool holding = seek_hold_.load();
+    if (holding && SDL_GetTicksNS() - seek_req_ns_.load() >= SEEK_HOLD_MAX_NS) {
+        release_seek_hold(clock, true);
+        holding = false;
+    }
+
+    // 창이 보이지 않으면 변환/업로드 없이 링만 비운다 (숨김 중엔 새 프레임도 오지 않음)
+    if (hidden_.load()) {
+        if (holding) release_seek_hold(clock, true);
+        while (frames_.peek()) frames_.pop();
+        if (eof_serial_.load() == serial) ended_ = true;
+        return !ended_.load();
+    }
+
+    while (FrameRing::Slot* s = frames_.peek()) {
+        if (s->serial != serial) { frames_.pop(); continue; }
+        // seek 대기 중이면 새 세대 첫 프레임은 pts 와 무관하게 즉시 표시
+        if (s->pts > clock && !holding) break;
+
+        // 다음 프레임도 이미 표시 시각이 지났으면 현재 프레임은 건너뜀
+        const FrameRing::Slot* next = frames_.peek(1);
+        if (!holding && next && next->serial == serial && next->pts <= clock) {
+            frames_.pop();
+            ++sync_stats_.dropped;
+            continue;
+        }
+
+        const Uint64 t0 = SDL_GetTicksNS();
+        if (s->dst_fmt != AV_PIX_FMT_NONE) convert_to_texture(*s);
+        else if (ensure_texture(s->frame)) upload_frame(s->frame);
+        upload_ms_total_ += static_cast<double>(SDL_GetTicksNS() - t0) / SDL_NS_PER_MS;
+        ++uploaded_frames_;
+
+        if (!scrubbing_.load()) cur_pts_ = s->pts;
+        if (holding) release_seek_hold(s->pts, false);
+        // scrub 중이면 다음 목표를 기다리는 디먹스 스레드를 깨운다
+        if (shown_serial_.exchange(serial) != serial && scrubbing_.load())
+            wake_workers();
+        frames_.pop();
+        break;
+    }
+
+    if (eof_serial_.load() == serial && frames_.size() == 0)
+        ended_ = true;
+
+    return !ended_.load();
+}
+
+/**
+ * @brief seek 대기 해제 – 클록을 pts 에서 다시 흐르게 하고 오디오 재개 (메인 스레드)
+ * @param timed_out 첫 프레임 없이 SEEK_HOLD_MAX_NS 가 지나 해제하는 경우 (통계 제외)
+ */
+void VideoPlayer::release_seek_hold(double pts, bool timed_out) {
+    set_clock(pts);
+    seek_hold_ = false;   // 오디오 콜백도 다시 링을 꺼내 가기 시작
+
+    const double ms = static_cast<double>(SDL_GetTicksNS() - seek_req_ns_.load()) / SDL_NS_PER_MS;
+    if (timed_out) {
+        std::cout << "[비디오] seek 후 " << static_cast<int>(ms) << "ms 동안 프레임 없음 – 클록 재개\n";
+        return;
+    }
+    ++seek_count_;
+    seek_ms_total_ += ms;
+    seek_ms_last_   = ms;
+    std::cout << "[비디오] seek → 첫 프레임 " << static_cast<int>(ms) << "ms (선행 "
+              << preroll_dropped_.load() << "프레임 디코딩만"
+              << (opts_.accurate_seek ? ")\n" : ", 빠른 seek)\n");
+}
+
+/**
+ * @brief 렌더러가 fmt 텍스처를 지원하는지 검사
+ */
+bool VideoPlayer::supports_texture_format(SDL_PixelFormat fmt) const {
+    if (fmt == SDL_PIXELFORMAT_UNKNOWN) return false;
+    return std::find(texture_formats_.begin(), texture_formats_.end(), fmt)
+        != texture_formats_.end();
+}
+
+/**
+ * @brief 프레임 포맷/크기와 다르면 스트리밍 텍스처를 (재)생성
+ *
+ *  SDL 렌더 API 는 메인 스레드 전용이므로 update()에서만 호출한다.
+ *  YUV 텍스처는 프레임 색 공간(BT.601/709/2020, limited/full)을 지정해 생성한다.
+ */
+bool VideoPlayer::ensure_texture(const AVFrame* frame) {
+    const SDL_PixelFormat fmt = to_sdl_format(frame->format);
+    if (fmt == SDL_PIXELFORMAT_UNKNOWN) return false;
+    if (texture_ && fmt == texture_fmt_ &&
+        frame->width == texture_w_ && frame->height == texture_h_)
+        return true;
+    return ensure_texture(fmt, frame->width, frame->height, to_sdl_colorspace(frame));
+}
+
+bool VideoPlayer::ensure_texture(SDL_PixelFormat fmt, int w, int h, SDL_Colorspace cs) {
+    if (texture_ && fmt == texture_fmt_ && w == texture_w_ && h == texture_h_)
+        return true;
+
+    if (texture_) { SDL_DestroyTexture(texture_); texture_ = nullptr; }
+
+    SDL_PropertiesID props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_FORMAT_NUMBER,     fmt);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_ACCESS_NUMBER,     SDL_TEXTUREACCESS_STREAMING);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER,      w);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER,     h);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_COLORSPACE_NUMBER, cs);
+    texture_ = SDL_CreateTextureWithProperties(renderer_, props);
+    SDL_DestroyProperties(props);
+
+    if (!texture_) {
+        std::cerr << "[비디오] 텍스처 생성 실패: " << SDL_GetError() << "\n";
+        return false;
+    }
+    texture_fmt_ = fmt;
+    texture_w_   = w;
+    texture_h_   = h;
+    return true;
+}
+
+/**
+ * @brief 프레임 평면을 텍스처 포맷에 맞는 SDL 업로드 함수로 전달
+ */
+void VideoPlayer::upload_frame(const AVFrame* frame) {
+    switch (texture_fmt_) {
+    case SDL_PIXELFORMAT_IYUV:
+        SDL_UpdateYUVTexture(texture_, nullptr,
+                             frame->data[0], frame->linesize[0],
+                             frame->data[1], frame->linesize[1],
+                             frame->data[2], frame->linesize[2]);
+        break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+    case SDL_PIXELFORMAT_P010:
+        SDL_UpdateNVTexture(texture_, nullptr,
+                            frame->data[0], frame->linesize[0],
+                            frame->data[1], frame->linesize[1]);
+        break;
+    default:
+        SDL_UpdateTexture(texture_, nullptr,
+                          frame->data[0], frame->linesize[0]);
+        break;
+    }
+}
+
+/// 잠근 텍스처 메모리는 SDL 소유 – AVBufferRef 해제 시 아무것도 하지 않음
+static void no_free(void*, uint8_t*) {}
+
+/**
+ * @brief 슬롯의 디코더 프레임을 SDL_LockTexture 로 얻은 메모리에 바로 변환
+ *
+ *  변환 버퍼 → SDL_UpdateTexture 로 한 번 더 복사하던 것을 없앤다.
+ *  IYUV 는 SDL 잠금 메모리 배치(Y, U, V 평면 연속, 크로마 pitch 는 절반)를 따른다.
+ *  sws_scale_frame 은 출력 프레임에 버퍼 참조를 요구하므로 잠근 메모리를
+ *  해제하지 않는 AVBufferRef 로 감싼다.
+ */
+bool VideoPlayer::convert_to_texture(const FrameRing::Slot& slot) {
+    const AVFrame* src = slot.frame;
+    const bool     rgba = slot.dst_fmt == AV_PIX_FMT_RGBA;
+    // 행렬은 소스 기준 (slot.dst_h 로 추정하면 축소 출력에서 BT.601 로 틀어짐)
+    const SDL_Colorspace cs = to_sdl_colorspace(slot.dst_fmt, resolve_colorspace(src), AVCOL_RANGE_MPEG);
+    if (!ensure_texture(rgba ? SDL_PIXELFORMAT_RGBA32 : SDL_PIXELFORMAT_IYUV,
+                        slot.dst_w, slot.dst_h, cs))
+        return false;
+
+    const auto src_fmt = static_cast<AVPixelFormat>(src->format);
+    if (!sws_ctx_ ||
+        src->width  != sws_src_w_ || src->height  != sws_src_h_ || src_fmt      != sws_src_fmt_ ||
+        slot.dst_w  != sws_dst_w_ || slot.dst_h   != sws_dst_h_ || slot.dst_fmt != sws_dst_fmt_)
+    {
+        if (!init_sws(src->width, src->height, src_fmt, slot.dst_w, slot.dst_h, slot.dst_fmt))
+            return false;
+    }
+    if (!lock_frame_ && !(lock_frame_ = av_frame_alloc())) return false;
+
+    void* pixels = nullptr;
+    int   pitch  = 0;
+    if (!SDL_LockTexture(texture_, nullptr, &pixels, &pitch)) return false;
+
+    auto* base = static_cast<uint8_t*>(pixels);
+    const int    chroma_pitch = (pitch + 1) / 2;
+    const int    chroma_h     = (slot.dst_h + 1) / 2;
+    const size_t size = rgba ? static_cast<size_t>(pitch) * slot.dst_h
+                             : static_cast<size_t>(pitch) * slot.dst_h
+                               + static_cast<size_t>(chroma_pitch) * chroma_h * 2;
+
+    lock_frame_->buf[0] = av_buffer_create(base, size, no_free, nullptr, 0);
+    if (!lock_frame_->buf[0]) { SDL_UnlockTexture(texture_); return false; }
+    lock_frame_->format      = slot.dst_fmt;
+    lock_frame_->width       = slot.dst_w;
+    lock_frame_->height      = slot.dst_h;
+    lock_frame_->data[0]     = base;
+    lock_frame_->linesize[0] = pitch;
+    if (!rgba) {
+        lock_frame_->data[1]     = base + static_cast<size_t>(pitch) * slot.dst_h;
+        lock_frame_->data[2]     = lock_frame_->data[1] + static_cast<size_t>(chroma_pitch) * chroma_h;
+        lock_frame_->linesize[1] = chroma_pitch;
+        lock_frame_->linesize[2] = chroma_pitch;
+    }
+
+    const Uint64 t0 = SDL_GetTicksNS();
+    const bool   ok = sws_scale_frame(sws_ctx_, lock_frame_, src) >= 0;
+    add_convert_time(static_cast<double>(SDL_GetTicksNS() - t0) / SDL_NS_PER_MS);
+
+    av_frame_unref(lock_frame_);
+    SDL_UnlockTexture(texture_);
+    return ok;
+}
+
+// ── 백그라운드: 디먹스 스레드 ────────────────────────────────────
+
+/**
+ * @brief 모든 큐가 충분히 찼거나 총량이 한도를 넘었는지 검사
+ *
+ *  한 스트림 큐만 찼을 때 멈추면 다른 스트림이 굶으므로,
+ *  활성 큐가 모두 찼을 때만 멈춘다 (총량 한도는 메모리 상한).
+ */
+bool VideoPlayer::queues_full() const {
+    const bool has_audio = audio_ctx_ && audio_stream_;
+    const size_t total   = video_q_.bytes() + (has_audio ? audio_q_.bytes() : 0);
+    if (total >= TOTAL_QUEUE_BYTES) return true;
+    return video_q_.is_full() && (!has_audio || audio_q_.is_full());
+}
+
+/**
+ * @brief 디먹스 스레드 메인 루프
+ *
+ *  - seek 처리: seek_demuxer() 후 각 큐에 플러시 마커 삽입
+ *  - scrub 모드: 목표를 합쳐 키프레임 하나씩만 보냄 (오디오/자막 패킷은 버림)
+ *  - 패킷 읽기 → 비디오/오디오 큐 분배
+ *  - 내장 자막: 디코딩 비용이 작으므로 이 스레드에서 직접 처리
+ */
+void VideoPlayer::demux_loop() {
+    AVPacket* pkt           = av_packet_alloc();
+    bool      eof_sent      = false;
+    bool      scrub_sent    = true;   ///< 현재 scrub seek 의 키프레임을 보냈는지
+    int       scrub_skipped = 0;      ///< 키프레임을 찾으며 건너뛴 비디오 패킷 수
+    Uint64    scrub_seek_ns = 0;      ///< 마지막 scrub seek 시각
+
+    while (running_.load()) {
+        // 아래 상태 확인보다 먼저 읽어 두어야 그 사이의 이벤트를 놓치지 않음
+        const uint32_t wake_seq = wake_seq_.load();
+
+        // ── Seek 처리 ────────────────────────────────────────────
+        double seek_val = seek_target_.load();
+        if (seek_val >= 0.0) {
+            seek_target_ = -1.0;
+
+            seek_demuxer(seek_val);
+            // 빠른 seek 은 선행 구간 없이 직전 키프레임부터 표시
+            flush_pipeline(opts_.accurate_seek ? seek_val : -1.0);
+            eof_sent = false;
+        }
+
+        // ── Scrub (진행바 드래그) ────────────────────────────────
+        // 드래그 중 쌓이는 목표는 최신 것 하나로 합치고, 직전 scrub 프레임이
+        // 표시되었거나 SCRUB_MAX_WAIT_NS 가 지났을 때만 다음 seek 를 수행한다.
+        if (scrubbing_.load()) {
+            const double target = scrub_target_.load();
+            const bool   ready  = shown_serial_.load() == serial_.load() ||
+                                  SDL_GetTicksNS() - scrub_seek_ns >= SCRUB_MAX_WAIT_NS;
+            if (target >= 0.0 && ready) {
+                scrub_target_ = -1.0;
+                ++serial_;
+                set_clock(target);
+                seek_demuxer(target);
+                flush_pipeline(-1.0);   // 선행 구간 없음 – 키프레임을 그대로 표시
+                scrub_seek_ns = SDL_GetTicksNS();
+                scrub_sent    = false;
+                scrub_skipped = 0;
+            }
+
+            if (!scrub_sent) {
+                // 비디오 키프레임 패킷 하나만 보내고 EOF 로 드레인시켜
+                // 프레임 스레딩 디코더도 곧바로 프레임을 내놓게 한다
+                if (av_read_frame(format_ctx_, pkt) < 0) {
+                    video_q_.set_eof();
+                    scrub_sent = true;
+                } else {
+                    // 키 플래그가 없는 스트림 대비: 너무 오래 못 찾으면 그냥 보냄
+                    if (pkt->stream_index == video_stream_idx_ &&
+                        ((pkt->flags & AV_PKT_FLAG_KEY) ||
+                         ++scrub_skipped >= SCRUB_MAX_SKIPPED)) {
+                        video_q_.push(pkt);
+                        video_q_.set_eof();
+                        scrub_sent = true;
+                    }
+                    av_packet_unref(pkt);
+                }
+            } else if (target >= 0.0) {
+                // 이전 scrub 프레임 표시(update 가 깨움) 또는 대기 한도까지
+                const Uint64 waited = SDL_GetTicksNS() - scrub_seek_ns;
+                wait_event(wake_seq, waited < SCRUB_MAX_WAIT_NS ? SCRUB_MAX_WAIT_NS - waited : 1);
+            } else {
+                wait_event(wake_seq);   // 다음 scrub 목표 / seek / stop
+            }
+            eof_sent = false;
+            continue;
+        }
+
+        // ── 큐 용량 제한 ─────────────────────────────────────────
+        // 디코더가 pop 하면 demux_waiting_ 을 보고 깨운다 (플래그를 먼저 세워야 함)
+        demux_waiting_ = true;
+        const bool full = queues_full();
+        if (full) wait_event(wake_seq);
+        demux_waiting_ = false;
+        if (full) continue;
+
+        // ── 패킷 읽기 ────────────────────────────────────────────
+        if (av_read_frame(format_ctx_, pkt) < 0) {
+            if (!eof_sent) {
+                video_q_.set_eof();
+                audio_q_.set_eof();
+                eof_sent = true;
+            }
+            wait_event(wake_seq);   // seek / scrub / stop 까지
+            continue;
+        }
+
+        if (pkt->stream_index == video_stream_idx_) {
+            if (pkt->duration > 0)
+                demuxed_us_ += static_cast<int64_t>(pkt->duration * av_q2d(video_stream_->time_base) * 1e6);
+            video_q_.push(pkt);
+        } else if (pkt->stream_index == audio_stream_idx_ &&
+                   audio_ctx_ && audio_stream_) {
+            audio_q_.push(pkt);
+        } else if (use_embedded_sub_ &&
+                   pkt->stream_index == subtitle_stream_idx_ &&
+                   subtitle_ctx_) {
+            decode_subtitle_packet(pkt);
+        }
+
+        av_packet_unref(pkt);
+    }
+
+    av_packet_free(&pkt);
+}
+
+/**
+ * @brief seek 직후 파이프라인 비우기 (디먹스 스레드)
+ * @param pos 디코더가 버릴 선행 구간의 끝 (초, <0 이면 없음)
+ *
+ *  디코더 플러시 / 오디오 스트림 비우기는 각 디코더 스레드가 마커를 받아 수행.
+ */
+void VideoPlayer::flush_pipeline(double pos) {
+    const int serial = serial_.load();
+    video_q_.flush(pos, serial);
+    audio_q_.flush(pos, serial);
+    if (subtitle_ctx_) avcodec_flush_buffers(subtitle_ctx_);
+
+    // seek 후 내장 자막 캐시 비우기 (외부 파일 자막은 그대로 유지)
+    if (use_embedded_sub_) {
+        std::lock_guard<std::mutex> lk(subtitle_mutex_);
+        subtitle_track_.clear();
+    }
+}
+
+/**
+ * @brief 디먹서를 secs 직전 키프레임으로 이동 (디먹스 스레드)
+ *
+ *  키프레임 인덱스가 목표 구간을 이미 훑었으면:
+ *    byte_seek_ : 키프레임 바이트 오프셋으로 바로 이동 (TS 계열)
+ *    그 외      : 새 인덱스 항목을 디먹서 인덱스에 주입한 뒤 타임스탬프 seek
+ *  인덱스가 없거나 실패하면 기존 av_seek_frame(BACKWARD).
+ *  목표 이전 프레임은 비디오 디코더가 선행 구간으로 버리므로 정확도는 같다.
+ */
+void VideoPlayer::seek_demuxer(double secs) {
+    KeyframeIndex::Entry kf{};
+    const bool indexed = kf_index_ &&
+                         kf_index_->stream_index() == video_stream_idx_ &&
+                         kf_index_->floor(secs, kf);
+
+    if (indexed && byte_seek_ &&
+        av_seek_frame(format_ctx_, -1, kf.pos, AVSEEK_FLAG_BYTE) >= 0)
+        return;
+
+    if (indexed && !byte_seek_) {
+        std::vector<KeyframeIndex::Entry> fresh;
+        kf_injected_ = kf_index_->copy_since(kf_injected_, fresh);
+        for (const auto& e : fresh)
+            av_add_index_entry(video_stream_, e.pos, e.ts, 0, 0, AVINDEX_KEYFRAME);
+    }
+
+    av_seek_frame(format_ctx_, -1,
+                  static_cast<int64_t>(secs * AV_TIME_BASE),
+                  AVSEEK_FLAG_BACKWARD);
+}
+
+/**
+ * @brief 가장 가까운 키프레임 시각 (진행바 드래그용)
+ *
+ *  키프레임 위치로 seek 하면 선행 구간 디코딩이 없어 즉시 화면이 바뀐다.
+ *  인덱스가 없거나 아직 비어 있으면 secs 를 그대로 돌려준다.
+ */
+double VideoPlayer::snap_to_keyframe(double secs) const {
+    KeyframeIndex::Entry kf{};
+    if (kf_index_ && kf_index_->nearest(secs, kf)) return kf.secs;
+    return secs;
+}
+
+/**
+ * @brief 내장 자막 패킷 디코딩 → subtitle_track_ 에 추가
+ */
+void VideoPlayer::decode_subtitle_packet(const AVPacket* pkt) {
+    // 자막 디코딩: send/receive 패턴은 subtitle에 미적용 (FFmpeg 미지원)
+    // avcodec_decode_subtitle2가 자막 전용 유일한 정상 API
+    AVSubtitle sub{};
+    int got_sub = 0;
+    if (avcodec_decode_subtitle2(subtitle_ctx_, &sub, &got_sub, pkt) < 0 || !got_sub)
+        return;
+
+    AVStream* ssm = format_ctx_->streams[subtitle_stream_idx_];
+    double base   = av_q2d(ssm->time_base);
+    double start  = (pkt->pts != AV_NOPTS_VALUE)
+                  ? pkt->pts * base : 0.0;
+    double end    = (sub.end_display_time > 0)
+                  ? start + sub.end_display_time / 1000.0
+                  : start + 3.0;  // 기본 3초 표시
 
-    if (!video_ctx_) return;
+    for (unsigned r = 0; r < sub.num_rects; ++r) {
+        const AVSubtitleRect* rect = sub.rects[r];
+        std::string raw_text;
 
-    video_stream_ = format_ctx_->streams[video_stream_idx_];
+        if (rect->type == SUBTITLE_ASS && rect->ass)
+            raw_text = rect->ass;
+        else if (rect->type == SUBTITLE_TEXT && rect->text)
+            raw_text = rect->text;
 
-    // ── 자막 스트림 ──────────────────────────────────────────────
-    // 외부 파일 우선, 없으면 FFmpeg 내장 자막 스트림 열기
-    {
-        std::filesystem::path mpath(filename);
-        bool external_loaded;
-        {
+        if (!raw_text.empty()) {
             std::lock_guard<std::mutex> lk(subtitle_mutex_);
-            external_loaded = subtitle_track_.load_file(mpath);
+            subtitle_track_.add_ffmpeg_entry(start, end, raw_text);
         }
+    }
+    avsubtitle_free(&sub);
+}
 
-        if (external_loaded) {
-            std::wcout << L"[자막] 외부 파일 로드: "
-                       << mpath.stem().wstring() << L"\n";
-            use_embedded_sub_ = false;
-        } else {
-            // FFmpeg 내장 자막 스트림 탐색
-            open_codec(AVMEDIA_TYPE_SUBTITLE, subtitle_ctx_, subtitle_stream_idx_);
-            if (subtitle_stream_idx_ >= 0) {
-                use_embedded_sub_ = true;
-                std::cout << "[자막] 내장 스트림 #"
-                          << subtitle_stream_idx_ << " 활성화\n";
-            }
+// ── 백그라운드: 비디오 디코딩 스레드 ─────────────────────────────
+
+/**
+ * @brief 비디오 디코딩 스레드 메인 루프
+ *
+ *  - 플러시 마커: 코덱 버퍼를 비우고 이후 프레임에 새 serial 부착
+ *  - seek 목표 이전 프레임(키프레임부터의 선행 구간)은 스킵 판단 없이 버림
+ *  - EOF: 디코더에 남은 프레임을 모두 꺼낸 뒤 eof_serial_ 설정 (ended_ 는 update()가 판단)
+ *  - PTS 대기는 하지 않는다. frames_ 가 가득 차면 peek_writable()에서 블로킹
+ */
+void VideoPlayer::video_decode_loop() {
+    AVPacket* pkt     = av_packet_alloc();
+    AVFrame*  frame   = av_frame_alloc();
+    int       serial  = serial_.load();
+    double    preroll = -1.0;   ///< 이 PTS 이전 프레임은 seek 선행 구간
+
+    while (running_.load()) {
+        int        flush_serial = serial;
+        double     flush_pos    = -1.0;
+        const auto res          = video_q_.pop(pkt, &flush_pos, &flush_serial);
+        if (demux_waiting_.load()) wake_workers();
+
+        if (res == PacketQueue::PopResult::Aborted) break;
+
+        if (res == PacketQueue::PopResult::Flush) {
+            avcodec_flush_buffers(video_ctx_);
+            serial          = flush_serial;
+            preroll         = flush_pos;
+            preroll_dropped_ = 0;
+            late_avg_       = 0.0;
+            last_shown_pts_ = -1.0;
+            set_skip_level(0);
+            set_scrub_decode(scrubbing_.load());
+            continue;
         }
-    }
 
-    // ── RGBA 변환 버퍼 ────────────────────────────────────────────
-    int buf_sz = av_image_get_buffer_size(AV_PIX_FMT_RGBA,
-                                          video_ctx_->width,
-                                          video_ctx_->height, 1);
-    rgb_buffer_ = static_cast<uint8_t*>(av_malloc(buf_sz));
-    rgb_frame_  = av_frame_alloc();
-    av_image_fill_arrays(rgb_frame_->data, rgb_frame_->linesize,
-                         rgb_buffer_, AV_PIX_FMT_RGBA,
-                         video_ctx_->width, video_ctx_->height, 1);
+        if (res == PacketQueue::PopResult::Eof) {
+            // 디코더 드레인: 지연된 프레임(B-frame 등)까지 표시
+            avcodec_send_packet(video_ctx_, nullptr);
+        } else if (hidden_.load()) {
+            // 창이 보이지 않음 – 디코딩하지 않고 버림 (복원 시 seek 로 다시 맞춤)
+            av_packet_unref(pkt);
+            ++hidden_skipped_;
+            continue;
+        } else {
+            avcodec_send_packet(video_ctx_, pkt);
+            av_packet_unref(pkt);
+            if (skip_level_ >= 2) ++skip_sent_;
+        }
 
-    sws_ctx_ = sws_getContext(
-        video_ctx_->width, video_ctx_->height, video_ctx_->pix_fmt,
-        video_ctx_->width, video_ctx_->height, AV_PIX_FMT_RGBA,
-        SWS_BILINEAR, nullptr, nullptr, nullptr);
+        while (avcodec_receive_frame(video_ctx_, frame) == 0) {
+            if (skip_level_ >= 2) ++skip_recv_;
 
-    // SDL_Texture 생성 (생성자 = 메인 스레드이므로 안전)
-    texture_ = SDL_CreateTexture(renderer_,
-                                 SDL_PIXELFORMAT_RGBA32,
-                                 SDL_TEXTUREACCESS_STREAMING,
-                                 video_ctx_->width, video_ctx_->height);
+            const int64_t best_pts = frame->best_effort_timestamp;
+            if (best_pts == AV_NOPTS_VALUE || serial != serial_.load()) {
+                av_frame_unref(frame);
+                continue;
+            }
+            const double pts = best_pts * av_q2d(video_stream_->time_base);
 
-    // ── SDL 오디오 스트림 ─────────────────────────────────────────
-    if (audio_ctx_) {
-        SDL_AudioSpec spec{};
-        spec.format   = SDL_AUDIO_F32;
-        spec.channels = static_cast<Uint8>(audio_ctx_->ch_layout.nb_channels);
-        spec.freq     = audio_ctx_->sample_rate;
+            // seek 선행 구간: 디코딩만 하고 변환/게시/페이싱 없이 버림
+            if (pts + frame_duration_ <= preroll) {
+                ++preroll_dropped_;
+                av_frame_unref(frame);
+                continue;
+            }
+            preroll = -1.0;
 
-        audio_stream_device_ = SDL_OpenAudioDeviceStream(
-            SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, nullptr, nullptr);
-        if (audio_stream_device_) {
-            SDL_SetAudioStreamGain(audio_stream_device_, volume_.load());
-            SDL_ResumeAudioStreamDevice(audio_stream_device_);
+            if (!scrubbing_.load() &&
+                should_skip_frame(pts, (frame->flags & AV_FRAME_FLAG_KEY) != 0)) {
+                av_frame_unref(frame);
+                continue;
+            }
+            present_video_frame(frame, pts, serial);
         }
+
+        // scrub 의 EOF 는 키프레임 드레인용 – 재생 종료가 아님
+        if (res == PacketQueue::PopResult::Eof && !scrubbing_.load())
+            eof_serial_ = serial;
     }
+
+    set_skip_level(0);
+    av_frame_free(&frame);
+    av_packet_free(&pkt);
 }
 
 /**
- * @brief VideoPlayer 리소스 정리 (소멸자 및 재초기화 시 사용)
+ * @brief 디코더 discard 설정 변경
+ * @param level 0 = 전부 디코딩, 2 = 비참조 프레임/루프 필터 생략, 3 = 키프레임만
+ *
+ *  2/3단계에서 디코더가 버린 프레임은 출력되지 않으므로,
+ *  단계를 벗어날 때 (보낸 패킷 - 받은 프레임)으로 추정하여 카운트한다.
  */
-void VideoPlayer::cleanup() {
-    if (sws_ctx_)             { sws_freeContext(sws_ctx_);            sws_ctx_  = nullptr; }
-    if (rgb_frame_)           { av_frame_free(&rgb_frame_);                                }
-    if (rgb_buffer_)          { av_free(rgb_buffer_);                 rgb_buffer_ = nullptr;}
-    if (subtitle_ctx_)        { avcodec_free_context(&subtitle_ctx_);                      }
-    if (video_ctx_)           { avcodec_free_context(&video_ctx_);                         }
-    if (audio_ctx_)           { avcodec_free_context(&audio_ctx_);                         }
-    if (format_ctx_)          { avformat_close_input(&format_ctx_);                        }
-    if (audio_stream_device_) { SDL_DestroyAudioStream(audio_stream_device_);
-                                audio_stream_device_ = nullptr;                            }
-    if (texture_)             { SDL_DestroyTexture(texture_);         texture_  = nullptr; }
+void VideoPlayer::set_skip_level(int level) {
+    if (level == skip_level_) return;
+
+    if (skip_level_ >= 2 && skip_sent_ > skip_recv_)
+        skip_counts_[skip_level_] += skip_sent_ - skip_recv_;
+    skip_sent_ = 0;
+    skip_recv_ = 0;
+
+    switch (level) {
+    case 2:
+        video_ctx_->skip_frame       = AVDISCARD_NONREF;
+        video_ctx_->skip_loop_filter = AVDISCARD_ALL;
+        break;
+    case 3:
+        video_ctx_->skip_frame       = AVDISCARD_NONKEY;
+        video_ctx_->skip_loop_filter = AVDISCARD_ALL;
+        break;
+    default:
+        video_ctx_->skip_frame       = AVDISCARD_DEFAULT;
+        video_ctx_->skip_loop_filter = AVDISCARD_DEFAULT;
+        break;
+    }
+
+    if (level != 0 || skip_level_ != 0)
+        std::cout << "[비디오] 프레임 스킵 단계 " << skip_level_ << " → " << level
+                  << " (평균 지연 " << static_cast<int>(late_avg_ * 1000.0) << "ms)\n";
+    skip_level_ = level;
 }
 
 /**
- * @brief 전체 재생 길이 반환 (초)
+ * @brief scrub 디코딩 설정 (플러시 마커 직후, 비디오 스레드)
+ * @param on true 면 키프레임만, 루프 필터 생략 (scrub_fast_decode 면 IDCT 도 생략)
  */
-double VideoPlayer::get_length() const {
-    return raw_duration_ / static_cast<double>(AV_TIME_BASE);
+void VideoPlayer::set_scrub_decode(bool on) {
+    if (on) {
+        video_ctx_->skip_frame       = AVDISCARD_NONKEY;
+        video_ctx_->skip_loop_filter = AVDISCARD_ALL;
+        video_ctx_->skip_idct        = opts_.scrub_fast_decode ? AVDISCARD_ALL
+                                                               : AVDISCARD_DEFAULT;
+    } else {
+        // set_skip_level(0) 이 이미 0 단계였으면 값을 건드리지 않으므로 직접 복원
+        video_ctx_->skip_frame       = AVDISCARD_DEFAULT;
+        video_ctx_->skip_loop_filter = AVDISCARD_DEFAULT;
+        video_ctx_->skip_idct        = AVDISCARD_DEFAULT;
+    }
 }
 
 /**
- * @brief 볼륨 설정 (0.0~1.0)
+ * @brief 프레임 지연을 측정하여 스킵 단계를 조정하고, 이 프레임을 버릴지 결정
+ * @param pts 프레임 표시 시각 (초)
+ * @param key 키프레임 여부
+ * @return true 면 변환/업로드 없이 버림 (1단계)
+ *
+ *  지연이 한 프레임 간격을 넘으면 update()도 어차피 다음 프레임으로 건너뛰므로
+ *  변환/업로드 비용만 낭비된다. 단, 화면이 완전히 멈추지 않도록
+ *  VIDEO_SKIP_NONKEY_SEC 이상 아무것도 게시하지 못했으면 한 장은 통과시킨다.
  */
-void VideoPlayer::set_volume(float v) {
-    volume_ = SDL_clamp(v, 0.0f, 1.0f);
-    if (audio_stream_device_)
-        SDL_SetAudioStreamGain(audio_stream_device_, volume_.load());
+bool VideoPlayer::should_skip_frame(double pts, bool key) {
+    // seek 대기 중에는 클록이 멈춰 있어 지연을 잴 수 없음 – 첫 프레임은 어차피 바로 표시
+    if (seek_hold_.load()) { last_shown_pts_ = pts; return false; }
+
+    const double lateness = clock_now() - pts;
+    late_avg_ = late_avg_ * 0.9 + lateness * 0.1;
+
+    // ── 디코더 단계 조정 ────────────────────────────────────────
+    if (lateness >= VIDEO_SKIP_NONKEY_SEC) {
+        set_skip_level(3);
+    } else if (skip_level_ == 3) {
+        // 키프레임이 제시간에 나오면 따라잡은 것으로 본다
+        if (key && lateness <= 0.0) { late_avg_ = 0.0; set_skip_level(0); }
+    } else if (late_avg_ >= VIDEO_SKIP_NONREF_SEC) {
+        set_skip_level(2);
+    } else if (skip_level_ == 2 && late_avg_ < VIDEO_SKIP_NONREF_SEC * 0.25) {
+        set_skip_level(0);
+    }
+
+    // ── 1단계: 늦은 프레임 변환/업로드 생략 ─────────────────────
+    const bool starving = last_shown_pts_ < 0.0 ||
+                          pts - last_shown_pts_ >= VIDEO_SKIP_NONKEY_SEC;
+    if (lateness > frame_duration_ && !starving) {
+        ++skip_counts_[1];
+        return true;
+    }
+    last_shown_pts_ = pts;
+    return false;
 }
 
 /**
- * @brief 현재 시간에 해당하는 자막 텍스트 반환
+ * @brief 디코딩된 프레임을 frames_ 빈 슬롯에 게시
+ * @param frame  디코딩된 프레임 (호출 후 unref 됨)
+ * @param pts    표시 시각 (초)
+ * @param serial 이 프레임이 속한 seek 세대
+ *
+ *  - 화면 표시 크기가 원본보다 충분히 작으면 표시 크기로 축소 변환
+ *    (렌더러가 IYUV 를 지원하면 YUV420P, 아니면 RGBA)
+ *  - 아니고 렌더러가 프레임 포맷을 직접 지원하면 참조만 옮김 (복사 없음)
+ *  - 그 외에는 원본 크기 RGBA 변환
+ *  링이 가득 차 있으면 update()가 슬롯을 비울 때까지 대기한다.
  */
-std::string VideoPlayer::get_subtitle_text() const {
-    std::lock_guard<std::mutex> lk(subtitle_mutex_);
-    return subtitle_track_.get_active(cur_pts_.load());
-}
+void VideoPlayer::present_video_frame(AVFrame* frame, double pts, int serial) {
+    FrameRing::Slot* slot = frames_.peek_writable();
+    if (!slot) {
+        av_frame_unref(frame);
+        return;
+    }
 
-// ── play / stop ───────────────────────────────────────────────────
+    int  dst_w  = frame->width;
+    int  dst_h  = frame->height;
+    const bool scaled = opts_.scale_to_output &&
+                        fit_output_size(frame->width, frame->height, dst_w, dst_h);
+
+    bool ok = true;
+    slot->dst_fmt = AV_PIX_FMT_NONE;
+    if (!scaled && supports_texture_format(to_sdl_format(frame->format))) {
+        av_frame_unref(slot->frame);
+        av_frame_move_ref(slot->frame, frame);
+    } else {
+        const AVPixelFormat dst_fmt =
+            (scaled && supports_texture_format(SDL_PIXELFORMAT_IYUV))
+            ? AV_PIX_FMT_YUV420P : AV_PIX_FMT_RGBA;
+        if (opts_.convert_in_texture) {
+            // 변환은 update() 가 잠근 텍스처에 직접 (드롭되는 프레임은 변환조차 안 함)
+            av_frame_unref(slot->frame);
+            av_frame_move_ref(slot->frame, frame);
+            slot->dst_fmt = dst_fmt;
+            slot->dst_w   = dst_w;
+            slot->dst_h   = dst_h;
+        } else {
+            ok = convert_frame(frame, slot->frame, dst_w, dst_h, dst_fmt);
+        }
+    }
+
+    if (ok) {
+        slot->pts    = pts;
+        slot->serial = serial;
+        frames_.push();
+    }
+    av_frame_unref(frame);
+}
 
 /**
- * @brief 디코딩 스레드 시작
+ * @brief 현재 출력 크기에 맞춘 Letterbox 표시 크기 계산
+ * @param src_w, src_h 원본 프레임 크기
+ * @param dst_w, dst_h 출력: 표시 크기 (짝수로 내림, 4:2:0 크로마용)
+ * @return 표시 크기가 원본 면적의 SCALE_MAX_AREA_RATIO 이하일 때만 true
+ *         (조금 줄이는 정도는 변환 비용이 업로드 절감보다 큼)
  */
-void VideoPlayer::play() {
-    if (running_.load()) return;
-    running_ = true;
-    ended_   = false;
-    decode_thread_ = std::thread(&VideoPlayer::decode_loop, this);
+bool VideoPlayer::fit_output_size(int src_w, int src_h, int& dst_w, int& dst_h) const {
+    const int out_w = out_w_.load();
+    const int out_h = out_h_.load();
+    if (out_w <= 0 || out_h <= 0 || src_w <= 0 || src_h <= 0) return false;
+
+    const double scale = std::min(static_cast<double>(out_w) / src_w,
+                                  static_cast<double>(out_h) / src_h);
+    if (scale * scale > SCALE_MAX_AREA_RATIO) return false;
+
+    dst_w = std::max(2, static_cast<int>(src_w * scale) & ~1);
+    dst_h = std::max(2, static_cast<int>(src_h * scale) & ~1);
+    return true;
 }
 
 /**
- * @brief 디코딩 스레드 중지 및 대기
+ * @brief 화면(렌더 출력) 크기 통지 – 창 크기 변경 시 메인 스레드에서 호출
+ *
+ *  다음 프레임부터 새 크기로 변환하며, sws 컨텍스트와 텍스처는
+ *  크기가 달라진 첫 프레임에서 각각 convert_frame() / ensure_texture() 가 다시 만든다.
  */
-void VideoPlayer::stop() {
-    running_ = false;
-    if (decode_thread_.joinable())
-        decode_thread_.join();
+void VideoPlayer::set_output_size(int w, int h) {
+    out_w_ = w;
+    out_h_ = h;
 }
 
-// ── 메인 스레드: update() ────────────────────────────────────────
+/**
+ * @brief 스레드 sws 컨텍스트 (재)생성
+ *
+ *  sws_getContext/sws_getCachedContext 는 "threads" 옵션을 받지 않으므로
+ *  sws_alloc_context + av_opt_set 으로 만든다. threads > 1 이면 sws_scale_frame 이
+ *  출력 가로 슬라이스를 내부 워커 스레드에 나누어 변환한다.
+ */
+bool VideoPlayer::init_sws(int src_w, int src_h, AVPixelFormat src_fmt,
+                           int dst_w, int dst_h, AVPixelFormat dst_fmt) {
+    if (sws_ctx_) { sws_freeContext(sws_ctx_); sws_ctx_ = nullptr; }
+
+    int threads = opts_.sws_threads;
+    if (threads <= 0) {
+        const int cores = static_cast<int>(std::thread::hardware_concurrency());
+        threads = std::clamp(cores, 1, SWS_MAX_AUTO_THREADS);
+    }
+
+    sws_ctx_ = sws_alloc_context();
+    if (!sws_ctx_) return false;
+
+    av_opt_set_int(sws_ctx_, "srcw",       src_w,        0);
+    av_opt_set_int(sws_ctx_, "srch",       src_h,        0);
+    av_opt_set_int(sws_ctx_, "src_format", src_fmt,      0);
+    av_opt_set_int(sws_ctx_, "dstw",       dst_w,        0);
+    av_opt_set_int(sws_ctx_, "dsth",       dst_h,        0);
+    av_opt_set_int(sws_ctx_, "dst_format", dst_fmt,      0);
+    av_opt_set_int(sws_ctx_, "sws_flags",  SWS_BILINEAR, 0);
+    av_opt_set_int(sws_ctx_, "threads",    threads,      0);
+
+    if (sws_init_context(sws_ctx_, nullptr, nullptr) < 0) {
+        sws_freeContext(sws_ctx_);
+        sws_ctx_ = nullptr;
+        return false;
+    }
+
+    sws_src_w_   = src_w;
+    sws_src_h_   = src_h;
+    sws_src_fmt_ = src_fmt;
+    sws_dst_w_   = dst_w;
+    sws_dst_h_   = dst_h;
+    sws_dst_fmt_ = dst_fmt;
+    std::cout << "[비디오] 변환 " << src_w << "x" << src_h << " → "
+              << dst_w << "x" << dst_h << " "
+              << (dst_fmt == AV_PIX_FMT_RGBA ? "RGBA" : "YUV420P")
+              << ", 스레드 " << threads << "\n";
+    return true;
+}
 
 /**
- * @brief 메인 루프에서 매 프레임 호출, 새 프레임이 있으면 텍스처 업데이트
- * @return false면 재생 종료 (ended_)
+ * @brief src 를 dst_w x dst_h, dst_fmt 로 변환하여 dst 에 기록
+ *
+ *  dst 가 디코더 프레임 참조를 들고 있거나 크기/포맷이 다르면 frame_pool_ 에서 버퍼를 받는다.
+ *  풀의 크기/포맷이 바뀌는 첫 프레임(첫 축소 출력, 창 크기 변경)에서는 슬롯 수 + 1 만큼
+ *  그 크기로 다시 채워 두어 이후 프레임이 할당하지 않게 한다.
+ *  입력/출력 크기나 픽셀 포맷이 바뀌면 (창 크기 변경 포함) sws 컨텍스트를 다시 만든다.
+ *  변환 시간은 convert_ms_avg_ 에 누적 (sws_threads = 1 과 비교용).
  */
-bool VideoPlayer::update() {
-    if (!frame_ready_.load()) return !ended_.load();
+bool VideoPlayer::convert_frame(const AVFrame* src, AVFrame* dst,
+                                int dst_w, int dst_h, AVPixelFormat dst_fmt) {
+    if (dst->format != dst_fmt ||
+        dst->width  != dst_w || dst->height != dst_h ||
+        !av_frame_is_writable(dst))
+    {
+        if (!frame_pool_.matches(dst_w, dst_h, dst_fmt))
+            frame_pool_.reserve(frames_.capacity() + 1, dst_w, dst_h, dst_fmt);
+        if (!frame_pool_.get(dst, dst_w, dst_h, dst_fmt)) return false;
+    }
 
-    std::lock_guard<std::mutex> lock(frame_mutex_);
-    if (frame_ready_.load()) {
-        SDL_UpdateTexture(texture_, nullptr,
-                          rgb_frame_->data[0], rgb_frame_->linesize[0]);
-        frame_ready_ = false;
+    const auto src_fmt = static_cast<AVPixelFormat>(src->format);
+    if (!sws_ctx_ ||
+        src->width != sws_src_w_ || src->height != sws_src_h_ || src_fmt != sws_src_fmt_ ||
+        dst_w      != sws_dst_w_ || dst_h       != sws_dst_h_ || dst_fmt != sws_dst_fmt_)
+    {
+        if (!init_sws(src->width, src->height, src_fmt, dst_w, dst_h, dst_fmt))
+            return false;
     }
-    return !ended_.load();
+
+    const Uint64 t0 = SDL_GetTicksNS();
+    if (sws_scale_frame(sws_ctx_, dst, src) < 0) return false;
+    const double ms = static_cast<double>(SDL_GetTicksNS() - t0) / SDL_NS_PER_MS;
+
+    // YUV 출력은 텍스처 colorspace 선택에 쓰인다 (sws 출력은 limited range,
+    // 행렬은 축소된 dst 높이가 아니라 소스 기준으로 정함)
+    dst->colorspace  = resolve_colorspace(src);
+    dst->color_range = AVCOL_RANGE_MPEG;
+
+    add_convert_time(ms);
+    return true;
+}
+
+void VideoPlayer::add_convert_time(double ms) {
+    convert_ms_total_ += ms;
+    convert_ms_avg_    = converted_frames_.load() == 0
+                       ? ms : convert_ms_avg_.load() * 0.95 + ms * 0.05;
+    ++converted_frames_;
 }
 
-// ── 백그라운드 디코딩 스레드 ─────────────────────────────────────
+// ── 백그라운드: 오디오 디코딩 스레드 ─────────────────────────────
 
 /**
- * @brief 디코딩 스레드 메인 루프
+ * @brief 오디오 디코딩 스레드 메인 루프
  *
- *  - seek 처리
- *  - 패킷 읽기 및 스트림별 디코딩
- *  - 비디오: sws_scale로 RGBA 변환 후 frame_ready_ 설정, PTS 기반 동기화 대기
- *  - 오디오: SDL 오디오 스트림으로 데이터 푸시
- *  - 내장 자막: AVSubtitle 파싱 → subtitle_track_에 추가
+ *  pcm_ 에 audio_high_water_ (audio_buffer_ms) 이상 쌓여 있으면 넘친 분량이 재생될 때까지
+ *  쉬고, 일시정지 중에는 재개될 때까지 잔다 (둘 다 wake_workers() 로 즉시 깨어남).
+ *  링은 디바이스가 요청할 때만 비워지므로 디코딩 속도는 재생 속도에 묶이고,
+ *  비디오 쪽 진행과 무관하게 쌓이는 양은 high-water + 배치 하나로 제한된다.
+ *  프레임을 넣을 때마다 audio_end_pts_ 를 갱신하여 오디오 마스터 클록의 기준으로 쓴다.
  */
-void VideoPlayer::decode_loop() {
-    AVPacket* pkt   = av_packet_alloc();
-    AVFrame*  frame = av_frame_alloc();
-    Uint64    start_ns = SDL_GetTicksNS();
+void VideoPlayer::audio_decode_loop() {
+    AVPacket* pkt    = av_packet_alloc();
+    AVFrame*  frame  = av_frame_alloc();
+    int       serial = serial_.load();
 
-    while (running_.load()) {
+    const size_t batch_bytes = static_cast<size_t>(audio_bytes_per_sec_ * AUDIO_BATCH_SEC);
+    const AVRational tb      = format_ctx_->streams[audio_stream_idx_]->time_base;
+    double       in_end      = -1.0;   ///< 마지막으로 디코딩한 프레임의 끝 PTS
 
-        // ── Seek 처리 ────────────────────────────────────────────
-        double seek_val = seek_target_.load();
-        if (seek_val >= 0.0) {
-            seek_target_ = -1.0;
+    while (running_.load()) {
+        const uint32_t wake_seq = wake_seq_.load();
 
-            av_seek_frame(format_ctx_, -1,
-                          static_cast<int64_t>(seek_val * AV_TIME_BASE),
-                          AVSEEK_FLAG_BACKWARD);
-            avcodec_flush_buffers(video_ctx_);
-            if (audio_ctx_)           avcodec_flush_buffers(audio_ctx_);
-            if (subtitle_ctx_)        avcodec_flush_buffers(subtitle_ctx_);
-            if (audio_stream_device_) SDL_ClearAudioStream(audio_stream_device_);
-
-            // seek 후 내장 자막 캐시 비우기 (외부 파일 자막은 그대로 유지)
-            if (use_embedded_sub_) {
-                std::lock_guard<std::mutex> lk(subtitle_mutex_);
-                subtitle_track_.clear();
-            }
+        if (paused_.load()) {
+            wait_event(wake_seq);   // 재개 / seek / stop 까지
+            continue;
+        }
 
-            start_ns = SDL_GetTicksNS()
-                     - static_cast<Uint64>(seek_val * SDL_NS_PER_SECOND);
-            cur_pts_ = seek_val;
+        // 넘친 만큼 재생될 시간 동안 쉼 (seek / pause / stop 이면 바로 깨어남)
+        const size_t queued = pcm_.size();
+        if (queued > audio_high_water_) {
+            wait_event(wake_seq, static_cast<Uint64>(static_cast<double>(queued - audio_high_water_)
+                                 / std::max(audio_bytes_per_sec_, 1.0) * SDL_NS_PER_SECOND) + 1);
+            continue;
         }
 
-        // ── 일시정지 ─────────────────────────────────────────────
-        if (paused_.load()) {
-            SDL_Delay(10);
-            start_ns += 10 * SDL_NS_PER_MS;
+        int        flush_serial = serial;
+        const auto res          = audio_q_.pop(pkt, nullptr, &flush_serial);
+        if (demux_waiting_.load()) wake_workers();
+
+        if (res == PacketQueue::PopResult::Aborted) break;
+
+        if (res == PacketQueue::PopResult::Eof) {
+            // 파일 끝: 리샘플러 꼬리와 모아 둔 배치를 마저 보냄
+            if (in_end >= 0.0) {
+                resample_audio(nullptr);
+                push_audio(in_end, serial);
+            }
+            audio_feeding_ = false;   // 이후 링이 비는 것은 언더런이 아님
             continue;
         }
 
-        // ── 패킷 읽기 ────────────────────────────────────────────
-        if (av_read_frame(format_ctx_, pkt) < 0) {
-            ended_ = true;
-            SDL_Delay(100);
+        if (res == PacketQueue::PopResult::Flush) {
+            avcodec_flush_buffers(audio_ctx_);
+            serial = flush_serial;
+            in_end = -1.0;
+            audio_buf_.clear();
+            if (swr_) swr_init(swr_);   // 재초기화 = 내부 지연 버퍼 폐기
+            audio_feeding_ = false;
+            std::lock_guard<std::mutex> lk(clock_mutex_);
+            pcm_.discard();
+            SDL_ClearAudioStream(audio_stream_);
+            audio_end_pts_ = -1.0;
+            audio_serial_  = serial;
             continue;
         }
 
-        // ── 비디오 패킷 ──────────────────────────────────────────
-        if (pkt->stream_index == video_stream_idx_) {
-            avcodec_send_packet(video_ctx_, pkt);
+        avcodec_send_packet(audio_ctx_, pkt);
+        av_packet_unref(pkt);
 
-            while (avcodec_receive_frame(video_ctx_, frame) == 0) {
-                // best_effort_timestamp: FFmpeg 5+ 에서 frame 필드로 직접 접근
-                int64_t best_pts = frame->best_effort_timestamp;
-                if (best_pts == AV_NOPTS_VALUE) {
-                    av_frame_unref(frame);
-                    continue;
-                }
-                const double pts = best_pts * av_q2d(video_stream_->time_base);
-
-                // PTS에 맞춰 대기 (너무 빠르게 디코딩되지 않도록)
-                // ✅ 수정: 남은 시간을 계산해서 한 번만 sleep
-                const Uint64 target_ns = start_ns + static_cast<Uint64>(pts * SDL_NS_PER_SECOND);
-                while (running_.load() && seek_target_.load() < 0.0) {
-                    Uint64 now_ns = SDL_GetTicksNS();
-                    if (now_ns >= target_ns) break;
-
-                    Uint64 remaining_ms = (target_ns - now_ns) / SDL_NS_PER_MS;
-                    if (remaining_ms > 1)
-                        SDL_Delay(static_cast<Uint32>(remaining_ms - 1)); // 1ms 여유 남기고 sleep
-                    else
-                        break; // 1ms 이내면 그냥 진행
-                }                
-                // while (running_.load() && seek_target_.load() < 0.0 &&
-                //        SDL_GetTicksNS() < start_ns +
-                //            static_cast<Uint64>(pts * SDL_NS_PER_SECOND))
-                // {
-                //     SDL_Delay(1);
-                // }
-
-                {
-                    std::lock_guard<std::mutex> lock(frame_mutex_);
-                    sws_scale(sws_ctx_,
-                              frame->data, frame->linesize,
-                              0, video_ctx_->height,
-                              rgb_frame_->data, rgb_frame_->linesize);
-                    frame_ready_ = true;
-                }
-                cur_pts_ = pts;
+        while (avcodec_receive_frame(audio_ctx_, frame) == 0) {
+            if (frame->best_effort_timestamp != AV_NOPTS_VALUE) {
+                in_end = frame->best_effort_timestamp * av_q2d(tb);
+            } else if (in_end < 0.0) {
+                av_frame_unref(frame);
+                continue;
             }
+            in_end += static_cast<double>(frame->nb_samples) / frame->sample_rate;
+            resample_audio(frame);
+            av_frame_unref(frame);
+
+            if (audio_buf_.size() >= batch_bytes) push_audio(in_end, serial);
         }
-        // ── 오디오 패킷 ──────────────────────────────────────────
-        else if (pkt->stream_index == audio_stream_idx_ &&
-                 audio_ctx_ && audio_stream_device_)
-        {
-            avcodec_send_packet(audio_ctx_, pkt);
-
-            while (avcodec_receive_frame(audio_ctx_, frame) == 0) {
-                if (av_sample_fmt_is_planar(
-                        static_cast<AVSampleFormat>(frame->format)))
-                {
-                    SDL_PutAudioStreamPlanarData(
-                        audio_stream_device_,
-                        const_cast<const void* const*>(
-                            reinterpret_cast<void* const*>(frame->data)),
-                        audio_ctx_->ch_layout.nb_channels,
-                        frame->nb_samples);
-                } else {
-                    int bytes = frame->nb_samples
-                              * audio_ctx_->ch_layout.nb_channels
-                              * av_get_bytes_per_sample(
-                                    static_cast<AVSampleFormat>(frame->format));
-                    SDL_PutAudioStreamData(
-                        audio_stream_device_, frame->data[0], bytes);
-                }
-            }
+    }
+
+    av_frame_free(&frame);
+    av_packet_free(&pkt);
+}
+
+/**
+ * @brief 오디오 프레임을 디바이스 형식으로 변환하여 audio_buf_ 뒤에 붙임
+ * @param frame 디코딩된 프레임, nullptr 이면 리샘플러 내부에 남은 샘플 배출
+ * @return 변환 성공 여부 (실패한 프레임은 버림)
+ *
+ *  입력 포맷/레이트/채널 레이아웃이 바뀌면(방송 TS 의 스테레오 ↔ 5.1 등)
+ *  그 자리에서 SwrContext 를 다시 만든다.
+ */
+bool VideoPlayer::resample_audio(const AVFrame* frame) {
+    if (frame && (frame->format      != swr_in_fmt_  ||
+                  frame->sample_rate != swr_in_rate_ ||
+                  av_channel_layout_compare(&frame->ch_layout, &swr_in_layout_) != 0))
+    {
+        if (swr_in_rate_ > 0)
+            std::cout << "[비디오] 오디오 입력 변경: " << frame->ch_layout.nb_channels << "ch "
+                      << frame->sample_rate << "Hz\n";
+
+        // 레이아웃 정보가 없는 스트림은 채널 수 기준 기본 레이아웃으로 간주
+        AVChannelLayout in_layout{};
+        if (frame->ch_layout.order == AV_CHANNEL_ORDER_UNSPEC)
+            av_channel_layout_default(&in_layout, frame->ch_layout.nb_channels);
+        else
+            av_channel_layout_copy(&in_layout, &frame->ch_layout);
+
+        swr_free(&swr_);
+        if (swr_alloc_set_opts2(&swr_, &out_layout_, out_fmt_, out_rate_,
+                                &in_layout, static_cast<AVSampleFormat>(frame->format),
+                                frame->sample_rate, 0, nullptr) < 0 ||
+            swr_init(swr_) < 0) {
+            std::cout << "[비디오] swresample 초기화 실패\n";
+            swr_free(&swr_);
         }
-        // ── 내장 자막 패킷 ───────────────────────────────────────
-        else if (use_embedded_sub_ &&
-                 pkt->stream_index == subtitle_stream_idx_ &&
-                 subtitle_ctx_)
+        av_channel_layout_uninit(&in_layout);
+
+        av_channel_layout_uninit(&swr_in_layout_);
+        av_channel_layout_copy(&swr_in_layout_, &frame->ch_layout);
+        swr_in_fmt_  = static_cast<AVSampleFormat>(frame->format);
+        swr_in_rate_ = frame->sample_rate;
+    }
+    if (!swr_) return false;
+
+    const int in_samples = frame ? frame->nb_samples : 0;
+    const int max_out    = swr_get_out_samples(swr_, in_samples);
+    if (max_out <= 0) return true;
+
+    const size_t old = audio_buf_.size();
+    audio_buf_.resize(old + static_cast<size_t>(max_out) * out_frame_bytes_);
+    uint8_t* out[1] = { audio_buf_.data() + old };
+    const int got = swr_convert(swr_, out, max_out,
+                                frame ? const_cast<const uint8_t**>(frame->extended_data) : nullptr,
+                                in_samples);
+    audio_buf_.resize(old + static_cast<size_t>(std::max(got, 0)) * out_frame_bytes_);
+    return got >= 0;
+}
+
+/**
+ * @brief 모아 둔 변환 결과를 pcm_ 에 기록하고 오디오 클록 기준 갱신
+ * @param in_end_pts 지금까지 디코딩한 입력의 끝 PTS (초)
+ *
+ *  리샘플러 안에 아직 남은 구간과 아직 링에 못 넣은 구간만큼은 출력되지 않았으므로
+ *  끝 PTS 에서 뺀다. 기록과 갱신을 한 락 안에서 – audio_clock() 이 중간 상태를 보지 않도록.
+ *  링이 가득 차면 콜백이 비울 때까지 기다리고, seek / stop 이면 나머지는 버린다.
+ */
+void VideoPlayer::push_audio(double in_end_pts, int serial) {
+    if (audio_buf_.empty()) return;
+
+    const double pending = swr_ ? static_cast<double>(swr_get_delay(swr_, out_rate_)) / out_rate_
+                                : 0.0;
+    const size_t frame   = static_cast<size_t>(out_frame_bytes_);
+    const size_t total   = audio_buf_.size();
+    size_t       done    = 0;
+
+    while (done < total && running_.load() && serial == serial_.load()) {
+        const uint32_t wake_seq = wake_seq_.load();
+        size_t         n        = 0;
         {
-            // 자막 디코딩: send/receive 패턴은 subtitle에 미적용 (FFmpeg 미지원)
-            // avcodec_decode_subtitle2가 자막 전용 유일한 정상 API
-            AVSubtitle sub{};
-            int got_sub = 0;
-            if (avcodec_decode_subtitle2(subtitle_ctx_, &sub, &got_sub, pkt) >= 0
-                && got_sub)
-            {
-                AVStream* ssm = format_ctx_->streams[subtitle_stream_idx_];
-                double base   = av_q2d(ssm->time_base);
-                double start  = (pkt->pts != AV_NOPTS_VALUE)
-                              ? pkt->pts * base : 0.0;
-                double end    = (sub.end_display_time > 0)
-                              ? start + sub.end_display_time / 1000.0
-                              : start + 3.0;  // 기본 3초 표시
-
-                for (unsigned r = 0; r < sub.num_rects; ++r) {
-                    const AVSubtitleRect* rect = sub.rects[r];
-                    std::string raw_text;
-
-                    if (rect->type == SUBTITLE_ASS && rect->ass)
-                        raw_text = rect->ass;
-                    else if (rect->type == SUBTITLE_TEXT && rect->text)
-                        raw_text = rect->text;
-
-                    if (!raw_text.empty()) {
-                        std::lock_guard<std::mutex> lk(subtitle_mutex_);
-                        subtitle_track_.add_ffmpeg_entry(start, end, raw_text);
-                    }
-                }
-                avsubtitle_free(&sub);
+            std::lock_guard<std::mutex> lk(clock_mutex_);
+            const size_t fit = std::min(total - done, pcm_.space()) / frame * frame;
+            n     = pcm_.write(audio_buf_.data() + done, fit);
+            done += n;
+            if (n > 0) {
+                audio_end_pts_ = in_end_pts - pending
+                               - static_cast<double>(total - done) / audio_bytes_per_sec_;
+                audio_serial_  = serial;
             }
         }
+        if (n > 0) continue;
 
-        av_packet_unref(pkt);
+        // 링이 가득 참 – 배치 하나가 재생될 시간만큼 (일시정지면 재개까지) 대기
+        if (paused_.load()) wait_event(wake_seq);
+        else                wait_event(wake_seq, static_cast<Uint64>(AUDIO_BATCH_SEC * SDL_NS_PER_SECOND));
     }
+    if (done > 0) audio_feeding_ = true;
+    audio_buf_.clear();
+}
 
-    av_frame_free(&frame);
-    av_packet_free(&pkt);
+// ── SDL 오디오 콜백 (디바이스 스레드) ─────────────────────────────
+
+void SDLCALL VideoPlayer::audio_callback(void* userdata, SDL_AudioStream* stream,
+                                         int additional, int total) {
+    (void)total;
+    static_cast<VideoPlayer*>(userdata)->feed_audio(stream, additional);
+}
+
+/**
+ * @brief 디바이스가 요청한 만큼 pcm_ 에서 꺼내 스트림에 넣음
+ *
+ *  일시정지/seek 대기 중에는 아무것도 넣지 않는다. 모자라면 SDL 이 나머지를 무음으로 채운다. 재생 중(audio_feeding_)에 모자란 경우만
+ *  언더런으로 센다 – 시작 직후, seek 플러시 직후, 파일 끝은 제외.
+ */
+void VideoPlayer::feed_audio(SDL_AudioStream* stream, int need) {
+    if (paused_.load() || seek_hold_.load()) return;   // 이 스트림만 무음 (디바이스는 계속)
+
+    uint8_t      chunk[AUDIO_CALLBACK_CHUNK];
+    const size_t step = AUDIO_CALLBACK_CHUNK / static_cast<size_t>(out_frame_bytes_)
+                      * static_cast<size_t>(out_frame_bytes_);
+
+    while (need > 0) {
+        const size_t n = pcm_.read(chunk, std::min(step, static_cast<size_t>(need)));
+        if (n == 0) break;
+        SDL_PutAudioStreamData(stream, chunk, static_cast<int>(n));
+        need -= static_cast<int>(n);
+    }
+    if (need > 0 && audio_feeding_.load()) {
+        ++audio_underruns_;
+        underrun_bytes_ += static_cast<uint64_t>(need);
+    }
 }
 
 // ════════════════════════════════════════════════════════════════════
@@ -525,18 +2018,78 @@ void ImagePlayer::seek_frames(int delta) {
 //  AudioPlayer
 // ════════════════════════════════════════════════════════════════════
 
+/// 크로스페이드 곡선 / FFT 창용
+static constexpr double half_pi = 1.57079632679489661923;
+
+/**
+ * @brief 제자리 radix-2 FFT (n 은 2의 거듭제곱)
+ */
+static void fft_radix2(std::complex<float>* a, int n) {
+    for (int i = 1, j = 0; i < n; ++i) {   // 비트 역순 정렬
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(a[i], a[j]);
+    }
+    for (int len = 2; len <= n; len <<= 1) {
+        const float               ang = -2.0f * static_cast<float>(half_pi * 2.0) / static_cast<float>(len);
+        const std::complex<float> wl(std::cos(ang), std::sin(ang));
+        for (int i = 0; i < n; i += len) {
+            std::complex<float> w(1.0f, 0.0f);
+            for (int k = 0; k < len / 2; ++k) {
+                const std::complex<float> u = a[i + k];
+                const std::complex<float> v = a[i + k + len / 2] * w;
+                a[i + k]           = u + v;
+                a[i + k + len / 2] = u - v;
+                w *= wl;
+            }
+        }
+    }
+}
+
 /**
  * @brief AudioPlayer 생성자
  * @param filepath 오디오 파일 경로 (와이드 문자열)
  * @param volume   초기 볼륨
  *
- *  BASS Song 로드, 외부 자막 탐색.
+ *  BASS 디코딩 채널 열기 → AudioEngine 에 스트림 연결, 외부 자막 탐색.
+ *  play() 전까지 콜백은 데이터를 주지 않으므로 미리 열어 두어도 소리가 나지 않는다.
  */
 AudioPlayer::AudioPlayer(const std::wstring& filepath, float volume) {
-    song_.load(filepath.c_str(), BASS_SAMPLE_FLOAT);
-    if (!song_.is_valid()) return;
+    volume_ = volume;
+
+#ifdef _WIN32
+    decode_ = BASS_StreamCreateFile(FALSE, filepath.c_str(), 0, 0,
+                                    BASS_STREAM_DECODE | BASS_SAMPLE_FLOAT | BASS_UNICODE);
+#else
+    const std::string utf8 = util::wstring_to_utf8(filepath);
+    decode_ = BASS_StreamCreateFile(FALSE, utf8.c_str(), 0, 0,
+                                    BASS_STREAM_DECODE | BASS_SAMPLE_FLOAT);
+#endif
+    if (!decode_) {
+        std::cout << "[오디오] BASS 디코딩 채널 열기 실패 (오류 " << BASS_ErrorGetCode() << ")\n";
+        return;
+    }
 
-    song_.set_volume(volume);
+    BASS_CHANNELINFO info{};
+    BASS_ChannelGetInfo(decode_, &info);
+    spec_.format   = SDL_AUDIO_F32;
+    spec_.channels = static_cast<int>(info.chans);
+    spec_.freq     = static_cast<int>(info.freq);
+    frame_bytes_   = spec_.channels * static_cast<int>(sizeof(float));
+
+    const QWORD bytes = BASS_ChannelGetLength(decode_, BASS_POS_BYTE);
+    if (bytes != static_cast<QWORD>(-1)) length_ = BASS_ChannelBytes2Seconds(decode_, bytes);
+
+    SDL_AudioSpec device{};
+    AudioEngine::instance().output_format(device, device_latency_);
+    stream_ = AudioEngine::instance().attach(spec_, &AudioPlayer::audio_callback, this);
+    if (!stream_) {
+        BASS_StreamFree(decode_);
+        decode_ = 0;
+        return;
+    }
+    SDL_SetAudioStreamGain(stream_, volume);
 
     // 외부 자막 파일 탐색 (.srt / .ass / .ssa)
     std::filesystem::path mpath(filepath);
@@ -545,27 +2098,205 @@ AudioPlayer::AudioPlayer(const std::wstring& filepath, float volume) {
     }
 }
 
+AudioPlayer::~AudioPlayer() {
+    AudioEngine::instance().detach(stream_);   // 반환 후 콜백 없음
+    // 이어 붙이기 전에 해제됨 (정리 시한 초과) – 걸어 둔 다음 곡은 지금이라도 시작
+    if (AudioPlayer* next = next_.exchange(nullptr)) next->play();
+    if (decode_) BASS_StreamFree(decode_);
+}
+
+void AudioPlayer::play() {
+    if (!is_valid()) return;
+    paused_  = false;
+    playing_ = true;
+}
+
+void AudioPlayer::stop() {
+    playing_ = false;
+    paused_  = false;
+    if (stream_) SDL_ClearAudioStream(stream_);
+}
+
 /**
- * @brief 일시정지 토글
+ * @brief 일시정지 토글 (스트림에 남은 샘플은 재개 시 이어서 재생)
  */
 void AudioPlayer::toggle_pause() {
-    if (song_.is_playing())     song_.pause();
-    else if (song_.is_paused()) song_.resume();
+    if (!playing_.load()) return;
+    paused_ = !paused_.load();
+}
+
+/**
+ * @brief 디코딩 위치 이동 후 스트림에 남은 이전 위치 샘플 버림
+ *
+ *  콜백과 같은 순서(스트림 잠금 → decode_mutex_)로 잠가, 이동과 비우기 사이에
+ *  콜백이 이전 위치 데이터를 넣지 못하게 한다.
+ */
+void AudioPlayer::seek(double secs) {
+    if (!is_valid()) return;
+    secs = std::clamp(secs, 0.0, std::max(0.0, length_));
+
+    SDL_LockAudioStream(stream_);
+    {
+        std::lock_guard<std::mutex> lk(decode_mutex_);
+        BASS_ChannelSetPosition(decode_, BASS_ChannelSeconds2Bytes(decode_, secs), BASS_POS_BYTE);
+        decode_ended_ = false;
+    }
+    SDL_ClearAudioStream(stream_);
+    SDL_UnlockAudioStream(stream_);
+}
+
+void AudioPlayer::set_volume(float v) {
+    volume_ = v;
+    if (stream_) SDL_SetAudioStreamGain(stream_, v);
+}
+
+/**
+ * @brief 들리는 위치 = 디코딩 위치 - 스트림에 남은 양 - 디바이스 지연
+ */
+double AudioPlayer::get_position() const {
+    if (!is_valid()) return 0.0;
+
+    QWORD pos;
+    {
+        std::lock_guard<std::mutex> lk(decode_mutex_);
+        pos = BASS_ChannelGetPosition(decode_, BASS_POS_BYTE);
+    }
+    if (pos == static_cast<QWORD>(-1)) return 0.0;
+
+    double    secs   = BASS_ChannelBytes2Seconds(decode_, pos);
+    const int queued = SDL_GetAudioStreamQueued(stream_);
+    if (queued > 0) secs -= static_cast<double>(queued) / (static_cast<double>(frame_bytes_) * spec_.freq);
+    if (playing_.load() && !paused_.load()) secs -= device_latency_;
+    return std::clamp(secs, 0.0, std::max(0.0, length_));
+}
+
+void SDLCALL AudioPlayer::audio_callback(void* userdata, SDL_AudioStream* stream,
+                                         int additional, int total) {
+    (void)total;
+    static_cast<AudioPlayer*>(userdata)->feed_audio(stream, additional);
+}
+
+/**
+ * @brief 디바이스가 요청한 만큼 디코딩해 스트림에 넣음 (모자라면 SDL 이 무음으로 채움)
+ */
+void AudioPlayer::feed_audio(SDL_AudioStream* stream, int need) {
+    if (!playing_.load() || paused_.load()) return;
+
+    float     chunk[1024];
+    const int step = static_cast<int>(sizeof(chunk)) / frame_bytes_ * frame_bytes_;
+
+    while (need > 0) {
+        const int n = decode(reinterpret_cast<uint8_t*>(chunk), std::min(step, need));
+        if (n <= 0) break;
+        push_scope(chunk, n / frame_bytes_);
+        SDL_PutAudioStreamData(stream, chunk, n);
+        need -= n;
+    }
+
+    if (decode_ended_.load()) {
+        if (AudioPlayer* next = next_.exchange(nullptr)) hand_over(stream, need, *next);
+    }
+}
+
+/**
+ * @brief 이 곡의 마지막 요청에서 남은 need 바이트를 다음 곡 앞부분으로 채운 뒤 다음 곡 재생 시작
+ *
+ *  다음 곡은 이후 요청부터 자기 스트림으로 이어서 넣는다. 잠금 순서는 seek() 와 같다
+ *  (이 스트림 잠금은 콜백 동안 SDL 이 쥐고 있음 → next.decode_mutex_).
+ */
+void AudioPlayer::hand_over(SDL_AudioStream* stream, int need, AudioPlayer& next) {
+    if (next.spec_.channels == spec_.channels && next.spec_.freq == spec_.freq) {
+        float     chunk[1024];
+        const int step = static_cast<int>(sizeof(chunk)) / frame_bytes_ * frame_bytes_;
+        while (need > 0) {
+            const int n = next.decode(reinterpret_cast<uint8_t*>(chunk), std::min(step, need));
+            if (n <= 0) break;
+            next.push_scope(chunk, n / frame_bytes_);
+            SDL_PutAudioStreamData(stream, chunk, n);
+            need -= n;
+        }
+    }
+    next.paused_  = false;
+    next.playing_ = true;
+}
+
+int AudioPlayer::decode(uint8_t* dst, int bytes) {
+    std::lock_guard<std::mutex> lk(decode_mutex_);
+    if (decode_ended_.load()) return 0;
+
+    const DWORD got = BASS_ChannelGetData(decode_, dst, static_cast<DWORD>(bytes));
+    if (got == static_cast<DWORD>(-1) ||
+        (got < static_cast<DWORD>(bytes) && BASS_ChannelIsActive(decode_) == BASS_ACTIVE_STOPPED)) {
+        decode_ended_ = true;
+    }
+    return got == static_cast<DWORD>(-1) ? 0 : static_cast<int>(got);
+}
+
+void AudioPlayer::push_scope(const float* samples, int frames) {
+    const int ch = spec_.channels;
+    std::lock_guard<std::mutex> lk(scope_mutex_);
+    for (int f = 0; f < frames; ++f) {
+        float sum = 0.0f;
+        for (int c = 0; c < ch; ++c) sum += samples[f * ch + c];
+        scope_[scope_pos_] = sum / static_cast<float>(ch);
+        scope_pos_         = (scope_pos_ + 1) % FFT_SIZE;
+    }
 }
 
 /**
- * @brief 매 프레임 호출, 종료 감지
+ * @brief 최근 출력 샘플의 크기 스펙트럼 (Hann 창, BASS_DATA_FFT512 와 비슷한 0~1 눈금)
+ * @param n 출력 개수 (최대 FFT_SIZE / 2)
+ */
+bool AudioPlayer::get_fft(float* buf, int n) const {
+    if (!is_valid()) return false;
+
+    std::complex<float> x[FFT_SIZE];
+    {
+        std::lock_guard<std::mutex> lk(scope_mutex_);
+        for (int i = 0; i < FFT_SIZE; ++i) {
+            const double w = 0.5 - 0.5 * std::cos(4.0 * half_pi * i / (FFT_SIZE - 1));
+            x[i] = scope_[(scope_pos_ + i) % FFT_SIZE] * static_cast<float>(w);
+        }
+    }
+    fft_radix2(x, FFT_SIZE);
+
+    const int count = std::min(n, FFT_SIZE / 2);
+    for (int i = 0; i < count; ++i)
+        buf[i] = std::abs(x[i]) * (4.0f / FFT_SIZE);   // 단측 ×2, Hann 이득 보정 ×2
+    return true;
+}
+
+void AudioPlayer::fade_to(float target, double secs) {
+    if (secs <= 0.0) {
+        fade_ns_ = 0;
+        set_volume(target);
+        return;
+    }
+    fade_from_ = volume_.load();
+    fade_to_   = target;
+    fade_t0_   = SDL_GetTicksNS();
+    fade_ns_   = static_cast<Uint64>(secs * SDL_NS_PER_SECOND);
+}
+
+/**
+ * @brief 매 프레임 호출, 볼륨 램프 진행 + 종료 감지
  * @return false면 ended_가 true가 되어 자동 전환 트리거
  */
 bool AudioPlayer::update() {
+    if (fade_ns_ > 0) {
+        const double t = std::min(1.0, static_cast<double>(SDL_GetTicksNS() - fade_t0_)
+                                       / static_cast<double>(fade_ns_));
+        const double w = fade_to_ > fade_from_ ? std::sin(t * half_pi)
+                                               : 1.0 - std::cos(t * half_pi);
+        set_volume(fade_from_ + static_cast<float>((fade_to_ - fade_from_) * w));
+        if (t >= 1.0) fade_ns_ = 0;
+    }
     if (ended_.load()) return false;
 
-    bool playing = song_.is_playing();
-    if (playing) {
-        was_playing_ = true;
-    } else if (was_playing_ && !song_.is_paused()) {
+    // 디코딩이 끝났고 스트림에 넣은 샘플도 디바이스로 다 넘어갔으면 종료
+    if (playing_.load() && decode_ended_.load() && SDL_GetAudioStreamQueued(stream_) == 0) {
         ended_ = true;
         return false;
     }
     return true;
-}
\ No newline at end of file
+}
@@ -30,11 +30,20 @@ extern "C" {
 #include <libavformat/avformat.h>
 #include <libavcodec/avcodec.h>
 #include <libswscale/swscale.h>
+#include <libswresample/swresample.h>
 #include <libavutil/imgutils.h>
+#include <libavutil/opt.h>
 #include <libavutil/time.h>
 }
 
 #include "bass3.hpp"
+#include "framering.h"
+#include "keyframeindex.h"
+#include "mediapool.h"
+#include "packetqueue.h"
+#include "pcmring.h"
+#include "probecache.h"
+#include "readahead.h"
 #include "subtitle.h"
 #include "util.hpp"
 
@@ -44,6 +53,8 @@ extern "C" {
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <mutex>
@@ -56,6 +67,31 @@ extern "C" {
 //  AppConfig
 // ──────────────────────────────────────────────────────────────────
 
+/**
+ * @struct VideoOptions
+ * @brief VideoPlayer 디코더 설정 (AppConfig::video)
+ */
+struct VideoOptions {
+    /// 디코더 스레딩 방식
+    enum class ThreadType {
+        Auto,   ///< 코덱별 기본 표를 따름
+        Frame,  ///< 프레임 단위 병렬 (처리량↑, 프레임 수만큼 지연)
+        Slice,  ///< 슬라이스 단위 병렬 (지연 없음, 슬라이스가 있는 스트림만 효과)
+        Both,   ///< 프레임 + 슬라이스 (코덱이 고름)
+    };
+
+    int        decoder_threads     = 0;                ///< 0 = 자동 (코어 수와 코덱별 상한), N = 고정
+    ThreadType decoder_thread_type = ThreadType::Auto; ///< 스레딩 방식
+    int        sws_threads         = 0;                ///< 변환 슬라이스 스레드 (0 = 자동, 1 = 단일 호출)
+    bool       scale_to_output     = true;             ///< 화면 표시 크기로 축소 변환 (원본이 충분히 클 때)
+    bool       scrub_fast_decode   = false;            ///< 드래그 미리보기에서 IDCT 도 생략 (지원 코덱만, 화질↓)
+    bool       huge_pages          = false;            ///< 변환 프레임 버퍼에 huge page 사용 요청 (Linux)
+    bool       convert_in_texture  = false;            ///< 변환 경로: 잠근 텍스처 메모리에 직접 변환 (메인 스레드, 복사 1회 절감)
+    bool       accurate_seek       = true;             ///< seek 목표 프레임부터 표시 (false = 직전 키프레임부터, 더 빠름)
+    int        readahead_mb        = 0;                ///< 전용 I/O 스레드 앞서 읽기 버퍼 (MB, 0 = 끔, 네트워크 마운트용)
+    int        audio_buffer_ms     = 1000;             ///< 오디오 PCM 링 high-water (ms, 넘으면 오디오 디코더 대기)
+};
+
 /**
  * @struct AppConfig
  * @brief 애플리케이션 설정 (mp.conf + 명령줄 인자 병합)
@@ -68,11 +104,15 @@ struct AppConfig {
     float delay_after     = 2.5f;             ///< 오디오 종료 후 다음 트랙까지 대기 시간(초)
     float image_display   = 5.0f;             ///< 정적 이미지 표시 시간(초)
     float short_threshold = 15.0f;            ///< 이 길이(초) 미만 오디오는 반복 재생
+    float crossfade       = -1.0f;            ///< 오디오→오디오 연속 재생: <0 끔 (delay_after), 0 = gapless, >0 크로스페이드(초)
 
     // 자막 설정
     std::string subtitle_font;                 ///< 폰트 파일 경로 (비어 있으면 자동 탐색)
     int         subtitle_size = 28;            ///< 폰트 크기 (pt)
 
+    VideoOptions video;                        ///< 비디오 디코더 설정
+    float thumbnail_cpu = 0.25f;               ///< 진행바 호버 썸네일 생성 CPU 비율 (0 = 끔)
+
     std::unordered_set<std::wstring> image_exts; ///< 이미지 확장자 목록
     std::unordered_set<std::wstring> audio_exts; ///< 오디오 확장자 목록
     std::unordered_set<std::wstring> video_exts; ///< 비디오 확장자 목록
@@ -103,13 +143,19 @@ public:
      */
     // virtual bool update()           = 0;
     // ✅ 수정: "화면이 갱신되었으면 true" (dirty flag)
-    // - VideoPlayer: frame_ready_ 가 true였을 때만 true 반환
+    // - VideoPlayer: 새 프레임을 텍스처에 올렸을 때만 true 반환
     // - ImagePlayer: 애니메이션 프레임이 넘어갔을 때만 true 반환
     //               정적 이미지는 항상 false (텍스처가 변하지 않음)
     // - AudioPlayer: 항상 false (텍스처 없음, FFT는 별도 처리)
     virtual bool update() = 0; // 반환 의미만 변경
     virtual void toggle_pause()     = 0;
     virtual void seek(double secs)  = 0;
+    /**
+     * @brief 미리보기 탐색 (진행바 드래그 중) – 기본은 seek() 와 같음
+     *
+     *  드래그를 끝낼 때 seek() 를 호출하면 정확한 위치로 탐색한다.
+     */
+    virtual void scrub(double secs) { seek(secs); }
     virtual void set_volume(float v)= 0;
 
     virtual double get_position()  const = 0;
@@ -139,6 +185,47 @@ public:
      */
     virtual std::string get_subtitle_text() const { return {}; }
 
+    /**
+     * @brief OSD 에 덧붙일 진단 정보 (A/V 동기 통계 등)
+     * @return 한 줄 UTF-8 문자열 (없으면 빈 문자열)
+     */
+    virtual std::string get_debug_info() const { return {}; }
+
+    /**
+     * @brief 렌더 출력 크기(픽셀) 통지 – 창 크기 변경 시 호출
+     *
+     *  VideoPlayer 는 이 크기에 맞춰 축소 변환하여 변환/업로드 대역폭을 줄인다.
+     */
+    virtual void set_output_size(int w, int h) { (void)w; (void)h; }
+
+    /**
+     * @brief secs 에 가장 가까운 키프레임 시각 (진행바 드래그 시 스냅용)
+     * @return 키프레임 정보가 없으면 secs 그대로
+     */
+    virtual double snap_to_keyframe(double secs) const { return secs; }
+
+    /**
+     * @brief 렌더러 리소스(텍스처) 해제 – 메인 스레드에서 호출
+     *
+     *  SDL 렌더러 객체는 메인 스레드에서만 다룰 수 있으므로, 소멸을 다른 스레드(Reaper)로
+     *  넘기기 전에 먼저 부른다. 이후에는 update()/get_texture() 를 쓰지 않는다.
+     */
+    virtual void release_textures() {}
+
+    /**
+     * @brief 창 표시 상태 통지 (최소화/숨김/완전히 가려짐이면 false) – 메인 스레드에서 호출
+     *
+     *  보이지 않는 동안에는 화면에 필요한 작업(변환/업로드)을 멈추고,
+     *  다시 보이면 현재 재생 위치에서 화면을 복구한다.
+     */
+    virtual void set_visible(bool visible) { (void)visible; }
+
+    /**
+     * @brief 이 플레이어가 잡고 있는 재생 버퍼 크기 (바이트, 미리 열기 비용 보고용)
+     * @return 알 수 없으면 0 (BASS 스트림 버퍼는 래퍼가 노출하지 않음)
+     */
+    virtual size_t buffered_bytes() const { return 0; }
+
     /**
      * @brief 0.0 ~ 1.0 사이의 재생 진행률
      */
@@ -156,9 +243,49 @@ public:
  * @class VideoPlayer
  * @brief FFmpeg 기반 비디오/오디오 재생, 내장/외부 자막 지원
  *
+ *  스레드 구성 (play() 에서 시작, stop() 에서 join):
+ *    demux_loop        : seek 처리, av_read_frame → 스트림별 PacketQueue, 내장 자막 디코딩
+ *    video_decode_loop : video_q_ → 디코딩 → frames_ (FrameRing)
+ *    audio_decode_loop : audio_q_ → 디코딩 → pcm_ (PcmRing) → SDL get 콜백 → 디바이스
+ *  각 단계가 독립적으로 진행되므로 느린 비디오 프레임이 오디오를 막지 않고,
+ *  큐가 비트레이트 급등을 흡수한다.
+ *
+ *  표시:
+ *    디코더는 frames_ 슬롯이 빌 때까지만 앞서 나가고, 메인 스레드 update()가
+ *    재생 클록(clock_now)에 맞는 프레임을 골라 업로드한다.
+ *    seek 마다 serial_ 이 증가하며, 이전 세대 프레임은 update()에서 폐기된다.
+ *
+ *  A/V 동기 (오디오 마스터):
+ *    오디오 클록 = pcm_ 에 넣은 마지막 샘플의 끝 PTS
+ *                - (pcm_ 잔량 + SDL_GetAudioStreamQueued) / 초당 바이트 - 디바이스 버퍼 지연
+ *    오디오 클록은 디바이스 버퍼 단위로 계단식으로 움직이므로, 표시 클록(벽시계)을
+ *    update() 마다 오디오 클록 쪽으로 조금씩 당겨(slew) 부드럽게 따라가게 한다.
+ *    표시 클록보다 늦은 프레임은 버리고, 앞선 프레임은 현재 프레임을 유지(반복)한다.
+ *    오디오가 없거나 다 재생된 뒤에는 벽시계만으로 진행한다.
+ *
+ *  부하 적응 프레임 스킵 (비디오 디코딩 스레드, 지연 = 클록 - 프레임 PTS):
+ *    1단계 : 이미 한 프레임 이상 늦은 프레임은 변환/업로드 없이 버림
+ *    2단계 : 평균 지연이 VIDEO_SKIP_NONREF_SEC 초과 → skip_frame = NONREF, 루프 필터 생략
+ *    3단계 : 지연이 VIDEO_SKIP_NONKEY_SEC 초과 → 따라잡을 때까지 키프레임만 디코딩
+ *
+ *  텍스처 업로드 경로:
+ *    직접 경로 : 렌더러가 지원하는 YUV 포맷(IYUV/NV12/NV21/P010)이면 디코더 프레임
+ *                참조를 링에 그대로 넣고 SDL_UpdateYUVTexture/SDL_UpdateNVTexture 로 업로드
+ *    폴백 경로 : 그 외 픽셀 포맷은 sws_scale_frame 으로 RGBA 변환 후 SDL_UpdateTexture
+ *                (스레드 sws: 가로 슬라이스를 VideoOptions::sws_threads 개 스레드에 분배)
+ *    축소 경로 : 화면 Letterbox 크기가 원본보다 충분히 작으면 (예: 4K → 720p 창)
+ *                그 크기로 축소 변환하여 업로드 (YUV420P 우선, 아니면 RGBA).
+ *                창 크기가 바뀌면 sws 컨텍스트와 텍스처를 다음 프레임에서 다시 만든다.
+ *
+ *  seek:
+ *    긴 파일은 KeyframeIndex 를 백그라운드로 만들어 seek_demuxer() 가 사용한다.
+ *    진행바 드래그는 scrub() 으로 미리보기 모드에 들어간다: 목표를 최신 것 하나로
+ *    합치고, snap_to_keyframe() 으로 붙인 키프레임만 디코딩해 바로 표시한다.
+ *    드래그를 끝내면 seek() 로 정확한 위치를 한 번 탐색한다.
+ *
  *  자막:
  *    - 생성자에서 외부 .srt/.ass 탐색 (있으면 subtitle_track_ 미리 로드)
- *    - 없으면 decode_loop에서 FFmpeg 내장 subtitle_stream_idx_ 디코딩
+ *    - 없으면 demux_loop에서 FFmpeg 내장 subtitle_stream_idx_ 디코딩
  *    - get_subtitle_text() : subtitle_mutex_ 로 보호된 접근
  */
 class VideoPlayer : public MediaPlayer {
@@ -166,16 +293,19 @@ public:
     /**
      * @param filename 비디오 파일 경로 (UTF-8)
      * @param renderer SDL_Renderer (텍스처 생성용)
+     * @param opts     디코더 스레딩 등 비디오 설정
      */
-    explicit VideoPlayer(const char* filename, SDL_Renderer* renderer);
+    VideoPlayer(const char* filename, SDL_Renderer* renderer,
+                const VideoOptions& opts = {});
     ~VideoPlayer() override { stop(); cleanup(); }
 
     void play()  override;
     void stop()  override;
     bool update()override;
 
-    void   toggle_pause()      override { paused_ = !paused_; }
-    void   seek(double secs)   override { seek_target_ = std::max(0.0, secs); ended_ = false; }
+    void   toggle_pause()      override;
+    void   seek(double secs)   override;
+    void   scrub(double secs)  override;
     void   set_volume(float v) override;
     double get_position() const override { return cur_pts_.load(); }
     double get_length()   const override;
@@ -186,36 +316,198 @@ public:
 
     SDL_Texture* get_texture()      const override { return texture_; }
     std::string  get_subtitle_text()const override;
+    std::string  get_debug_info()   const override;
+    void         set_output_size(int w, int h) override;
+    double       snap_to_keyframe(double secs) const override;
+    void         release_textures() override;
+    void         set_visible(bool visible) override;
+    size_t       buffered_bytes()   const override;
+
+    /// A/V 동기 통계 (메인 스레드 update()에서 갱신)
+    struct SyncStats {
+        double   drift     = 0.0; ///< 마지막 측정 오차 (오디오 - 표시 클록, 초)
+        double   drift_avg = 0.0; ///< 오차 지수 이동 평균 (초)
+        double   drift_max = 0.0; ///< 오차 절대값 최대 (초)
+        uint64_t resyncs   = 0;   ///< 오차가 커서 클록을 즉시 맞춘 횟수
+        uint64_t dropped   = 0;   ///< 늦어서 버린 프레임 수
+        uint64_t repeated  = 0;   ///< 영상이 앞서 유지(반복)한 프레임 간격 수
+    };
+    const SyncStats& sync_stats() const { return sync_stats_; }
+
+    /// 스킵 단계별 버린 프레임 수 (1 = 변환/업로드 생략, 2 = NONREF, 3 = 키프레임 전용)
+    uint64_t skipped_frames(int level) const {
+        return (level >= 1 && level <= 3) ? skip_counts_[level].load() : 0;
+    }
 
     /// @brief 플레이어가 정상 초기화되었는지 확인
-    bool is_valid() const { return format_ctx_ && video_ctx_ && texture_; }
+    bool is_valid() const { return format_ctx_ && video_ctx_ && (direct_ || sws_ctx_); }
 
 private:
-    void decode_loop();   ///< 백그라운드 디코딩 스레드 함수
-    void cleanup();       ///< 리소스 정리 (소멸자에서 호출)
+    void demux_loop();          ///< 디먹스 스레드: 패킷 읽기 → 큐 분배
+    void video_decode_loop();   ///< 비디오 디코딩 스레드
+    void audio_decode_loop();   ///< 오디오 디코딩 스레드
+    void present_video_frame(AVFrame* frame, double pts, int serial); ///< 프레임을 frames_ 에 게시 (필요 시 변환)
+    bool fit_output_size(int src_w, int src_h, int& dst_w, int& dst_h) const; ///< 축소 변환 크기 계산
+    void set_skip_level(int level);                             ///< 디코더 discard 설정 변경 (비디오 스레드)
+    void set_scrub_decode(bool on);                             ///< scrub 용 키프레임 전용 디코딩 (비디오 스레드)
+    bool should_skip_frame(double pts, bool key);               ///< 지연 측정 → 스킵 단계 조정, 1단계 드롭 판단
+    bool convert_frame(const AVFrame* src, AVFrame* dst,
+                       int dst_w, int dst_h, AVPixelFormat dst_fmt);  ///< sws 변환/축소 경로
+    bool init_sws(int src_w, int src_h, AVPixelFormat src_fmt,
+                  int dst_w, int dst_h, AVPixelFormat dst_fmt);       ///< 스레드 sws 컨텍스트 (재)생성
+    bool supports_texture_format(SDL_PixelFormat fmt) const;    ///< 렌더러가 해당 텍스처 포맷을 지원하는지
+    bool ensure_texture(const AVFrame* frame);                  ///< 프레임 포맷/크기에 맞는 텍스처 준비 (메인 스레드)
+    bool ensure_texture(SDL_PixelFormat fmt, int w, int h, SDL_Colorspace cs);
+    void upload_frame(const AVFrame* frame);                    ///< 포맷별 SDL 업로드 (메인 스레드)
+    bool convert_to_texture(const FrameRing::Slot& slot);       ///< SDL_LockTexture 메모리로 직접 변환 (메인 스레드)
+    void add_convert_time(double ms);                           ///< 변환 시간 통계 누적
+    std::string readahead_info() const;                         ///< OSD 용 앞서 읽기 버퍼 상태
+    void release_seek_hold(double pts, bool timed_out);         ///< 클록을 pts 에서 재개, 오디오 재개
+    void update_stream_discard();                               ///< 선택 외 스트림 AVDISCARD_ALL
+    double discarded_mb() const;                                ///< 버린 스트림 절약량 추정 (MB)
+    bool resample_audio(const AVFrame* frame);                   ///< 디바이스 형식으로 변환해 audio_buf_ 에 누적 (nullptr = 꼬리 배출)
+    void push_audio(double in_end_pts, int serial);              ///< audio_buf_ 를 pcm_ 에 기록 (공간이 날 때까지 대기) + 오디오 클록 갱신
+    /// SDL 오디오 스트림 get 콜백 (디바이스 스레드) → feed_audio()
+    static void SDLCALL audio_callback(void* userdata, SDL_AudioStream* stream, int additional, int total);
+    void feed_audio(SDL_AudioStream* stream, int need);          ///< pcm_ 에서 need 바이트까지 스트림으로 (락/할당 없음)
+    void decode_subtitle_packet(const AVPacket* pkt);            ///< 내장 자막 패킷 처리
+    bool queues_full() const;   ///< 디먹스를 잠시 멈춰야 하는지 (모든 큐가 참 / 총량 초과)
+    void seek_demuxer(double secs); ///< 디먹서 이동 (키프레임 인덱스 우선)
+    void flush_pipeline(double pos); ///< seek 후 큐/코덱/내장 자막 비우기
+    void cleanup();             ///< 리소스 정리 (소멸자에서 호출)
+    void wake_workers();        ///< 대기 중인 디먹스/오디오 스레드 깨우기 (seek/scrub/pause/stop/큐 여유)
+    void wait_event(uint32_t seq, Uint64 timeout_ns = 0); ///< seq 이후 wake_workers() 또는 시간 초과까지 대기 (0 = 무제한)
+
+    double clock_now() const;          ///< 현재 재생 클록 (초, 일시정지 중이면 고정)
+    void   set_clock(double pts);      ///< 재생 클록을 pts 로 재설정
+    double audio_clock(int serial) const; ///< 실제 재생된 오디오 위치 (초, 없으면 <0)
+    void   sync_to_audio(int serial);  ///< 표시 클록을 오디오 클록 쪽으로 보정 (메인 스레드)
+
+    // 패킷 큐 용량 (비트레이트 급등 흡수용, 4K HEVC 기준 수 초 분량)
+    static constexpr size_t VIDEO_QUEUE_BYTES   = 64u * 1024 * 1024;
+    static constexpr size_t VIDEO_QUEUE_PACKETS = 240;
+    static constexpr size_t AUDIO_QUEUE_BYTES   = 4u * 1024 * 1024;
+    static constexpr size_t AUDIO_QUEUE_PACKETS = 256;
+    static constexpr size_t TOTAL_QUEUE_BYTES   = 96u * 1024 * 1024;
+    static constexpr double AUDIO_BATCH_SEC      = 0.04; ///< 변환 결과를 모아 한 번에 푸시할 길이
+    static constexpr double AUDIO_RING_EXTRA_SEC = 0.5;  ///< pcm_ 용량 = high-water + 이만큼 (큰 프레임/꼬리 여유)
+    static constexpr size_t AUDIO_CALLBACK_CHUNK = 4096; ///< 콜백이 한 번에 옮기는 최대 바이트 (스택 버퍼)
+    static constexpr int    VIDEO_FRAME_SLOTS    = 4;   ///< 디코더가 앞서 나갈 수 있는 프레임 수
+    static constexpr double AV_SYNC_THRESHOLD    = 0.010; ///< 이 이하의 오차는 무시 (초)
+    static constexpr double AV_SYNC_SLEW         = 0.1;   ///< update() 1회당 보정 비율
+    static constexpr double AV_RESYNC_SEC        = 0.25;  ///< 이 이상 벌어지면 즉시 맞춤 (초)
+    static constexpr double VIDEO_SKIP_NONREF_SEC = 0.1;  ///< 평균 지연이 이 이상이면 2단계
+    static constexpr double VIDEO_SKIP_NONKEY_SEC = 0.5;  ///< 지연이 이 이상이면 3단계
+    static constexpr int    SWS_MAX_AUTO_THREADS  = 8;    ///< sws_threads 자동일 때 상한
+    static constexpr double SCALE_MAX_AREA_RATIO  = 0.75; ///< 표시 면적이 원본의 이 비율 이하일 때만 축소
+    static constexpr double KEYFRAME_INDEX_MIN_SEC = 300.0; ///< 이보다 긴 파일만 키프레임 인덱스 빌드
+    static constexpr Uint64 SCRUB_MAX_WAIT_NS = 150 * SDL_NS_PER_MS; ///< 이전 scrub 프레임을 기다리는 최대 시간
+    static constexpr int    SCRUB_MAX_SKIPPED = 300;  ///< scrub 키프레임 탐색 중 건너뛸 최대 비디오 패킷 수
+    static constexpr Uint64 SEEK_HOLD_MAX_NS  = 2 * SDL_NS_PER_SECOND; ///< seek 후 첫 프레임이 이보다 늦으면 클록 고정 해제
 
     // FFmpeg 자원
+    std::unique_ptr<ReadAhead> readahead_;           ///< format_ctx_->pb (readahead_mb > 0 일 때만, format_ctx_ 보다 늦게 해제)
     AVFormatContext* format_ctx_          = nullptr;
     AVCodecContext*  video_ctx_           = nullptr;
     AVCodecContext*  audio_ctx_           = nullptr;
     AVCodecContext*  subtitle_ctx_        = nullptr; ///< 내장 자막 코덱
     AVStream*        video_stream_        = nullptr;
-    SwsContext*      sws_ctx_             = nullptr; ///< 픽셀 포맷 변환 (YUV→RGBA)
-    AVFrame*         rgb_frame_           = nullptr; ///< RGBA 변환된 프레임 저장용
-    uint8_t*         rgb_buffer_          = nullptr; ///< rgb_frame_ 의 데이터 버퍼
+    SwsContext*      sws_ctx_             = nullptr; ///< 픽셀 포맷 변환 (폴백 경로, →RGBA)
+    int              sws_src_w_           = 0;       ///< sws_ctx_ 생성 시 입력 크기/포맷
+    int              sws_src_h_           = 0;
+    AVPixelFormat    sws_src_fmt_         = AV_PIX_FMT_NONE;
+    int              sws_dst_w_           = 0;       ///< sws_ctx_ 생성 시 출력 크기/포맷
+    int              sws_dst_h_           = 0;
+    AVPixelFormat    sws_dst_fmt_         = AV_PIX_FMT_NONE;
+    VideoOptions     opts_;                          ///< 생성 시 전달된 비디오 설정
     int              video_stream_idx_    = -1;
     int              audio_stream_idx_    = -1;
     int              subtitle_stream_idx_ = -1;      ///< FFmpeg 내장 자막 스트림 인덱스
+    int              discarded_streams_   = 0;       ///< AVDISCARD_ALL 로 표시한 스트림 수
+    int64_t          discarded_bps_       = 0;       ///< 그중 비트레이트를 아는 스트림의 합 (bit/s)
+    std::atomic<int64_t> demuxed_us_      {0};       ///< 디먹스한 비디오 패킷 길이 합 (절약량 추정용)
+
+    // 키프레임 인덱스 (프로세스 전역 캐시 공유)
+    std::shared_ptr<KeyframeIndex> kf_index_;        ///< 긴 파일만, 없으면 nullptr
+    size_t           kf_injected_         = 0;       ///< 디먹서 인덱스에 주입한 항목 수 (디먹스 스레드)
+    bool             byte_seek_           = false;   ///< 바이트 오프셋 seek 사용 (TS 계열)
 
     // SDL 자원
     SDL_Renderer*    renderer_             = nullptr;
-    SDL_Texture*     texture_             = nullptr; ///< 비디오 출력 텍스처
-    SDL_AudioStream* audio_stream_device_ = nullptr; ///< SDL 오디오 출력 스트림
+    SDL_Texture*     texture_             = nullptr; ///< 비디오 출력 텍스처 (update()에서 지연 생성)
+    SDL_PixelFormat  texture_fmt_         = SDL_PIXELFORMAT_UNKNOWN;
+    int              texture_w_           = 0;
+    int              texture_h_           = 0;
+    std::vector<SDL_PixelFormat> texture_formats_;   ///< 렌더러 지원 텍스처 포맷 목록
+    bool             direct_              = false;   ///< 코덱 출력 포맷을 그대로 업로드 가능
+    std::atomic<int> out_w_               {0};       ///< 렌더 출력 크기 (set_output_size)
+    std::atomic<int> out_h_               {0};
+    SDL_AudioStream* audio_stream_        = nullptr; ///< AudioEngine 디바이스에 연결한 이 플레이어의 스트림
 
     // 스레드 동기화
-    std::thread       decode_thread_;      ///< 디코딩 스레드
-    std::mutex        frame_mutex_;        ///< 프레임 데이터 보호 (frame_ready_)
-    std::atomic<bool> frame_ready_{false}; ///< 새 프레임이 준비되었는지 여부
+    std::thread       demux_thread_;       ///< 디먹스 스레드
+    std::thread       video_thread_;       ///< 비디오 디코딩 스레드
+    std::thread       audio_thread_;       ///< 오디오 디코딩 스레드
+    PacketQueue       video_q_{VIDEO_QUEUE_BYTES, VIDEO_QUEUE_PACKETS}; ///< demux → video
+    PacketQueue       audio_q_{AUDIO_QUEUE_BYTES, AUDIO_QUEUE_PACKETS}; ///< demux → audio
+    FrameRing         frames_{VIDEO_FRAME_SLOTS};  ///< video → update() (디코더 프레임 참조 또는 RGBA)
+    FrameBufferPool   frame_pool_;         ///< 변환 대상 프레임 버퍼 (64바이트 정렬)
+
+    // 디먹스/오디오 스레드 대기 (폴링 대신 이벤트로 깨움)
+    std::mutex              wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::atomic<uint32_t>   wake_seq_      {0};     ///< wake_workers() 마다 증가
+    std::atomic<bool>       demux_waiting_ {false}; ///< 디먹스가 큐 여유를 기다리는 중 (디코더가 pop 후 깨움)
+
+    // 재생 클록 (SDL_GetTicksNS 기준)
+    mutable std::mutex clock_mutex_;       ///< clock_base_ns_ / pause_clock_ 보호
+    int64_t            clock_base_ns_ = 0; ///< PTS 0 에 해당하는 시각
+    double             pause_clock_   = 0.0; ///< 일시정지 시점의 클록
+
+    // 오디오 마스터 클록 (clock_mutex_ 로 보호, 스트림 푸시와 함께 갱신)
+    double             audio_end_pts_  = -1.0; ///< SDL 스트림에 넣은 마지막 샘플의 끝 PTS
+    int                audio_serial_   = -1;   ///< audio_end_pts_ 의 seek 세대
+    double             audio_bytes_per_sec_ = 0.0; ///< SDL 스트림 입력 기준 초당 바이트
+    double             device_latency_ = 0.0;  ///< 디바이스 버퍼 지연 (초)
+    double             frame_duration_ = 1.0 / 30.0; ///< 공칭 프레임 간격 (초)
+    double             repeat_accum_   = 0.0;  ///< 반복 카운트용 누적 보정량 (초)
+    SyncStats          sync_stats_;
+
+    // 오디오 리샘플 (코덱 형식 → 디바이스 고유 형식, 오디오 스레드 전용)
+    SwrContext*          swr_             = nullptr;
+    AVChannelLayout      swr_in_layout_   {};                  ///< 현재 swr_ 입력 (형식 변경 감지용)
+    AVSampleFormat       swr_in_fmt_      = AV_SAMPLE_FMT_NONE;
+    int                  swr_in_rate_     = 0;
+    AVChannelLayout      out_layout_      {};                  ///< 디바이스 채널 레이아웃
+    AVSampleFormat       out_fmt_         = AV_SAMPLE_FMT_FLT; ///< 디바이스 샘플 포맷 (interleaved)
+    int                  out_rate_        = 0;
+    int                  out_frame_bytes_ = 0;                 ///< 출력 샘플 프레임(전 채널) 바이트
+    std::vector<uint8_t> audio_buf_;                           ///< pcm_ 에 넣기 전 모아 둔 변환 결과
+
+    // 오디오 PCM 링 (오디오 스레드 → SDL 콜백)
+    PcmRing               pcm_;
+    size_t                audio_high_water_ = 0;      ///< 이보다 많이 쌓이면 오디오 디코더 대기 (바이트)
+    std::atomic<bool>     audio_feeding_   {false};   ///< 현재 세대 데이터가 들어오는 중 (EOF/플러시 후 false – 언더런 집계 제외)
+    std::atomic<uint64_t> audio_underruns_ {0};       ///< 콜백 요청을 다 채우지 못한 횟수
+    std::atomic<uint64_t> underrun_bytes_  {0};       ///< 그때 모자란 바이트 합 (SDL 이 무음으로 채움)
+
+    // 부하 적응 스킵 (비디오 디코딩 스레드 전용, 카운터만 공유)
+    int                   skip_level_     = 0;    ///< 현재 디코더 discard 단계 (0/2/3)
+    double                late_avg_       = 0.0;  ///< 지연 지수 이동 평균 (초)
+    double                last_shown_pts_ = -1.0; ///< 마지막으로 게시한 프레임 PTS
+    uint64_t              skip_sent_      = 0;    ///< 2/3단계 진입 후 보낸 패킷 수
+    uint64_t              skip_recv_      = 0;    ///< 2/3단계 진입 후 받은 프레임 수
+    std::atomic<uint64_t> skip_counts_[4] {};     ///< 단계별 버린 프레임 수 ([0] 미사용)
+
+    // sws 변환 시간 (비디오 디코딩 스레드에서 갱신)
+    std::atomic<double>   convert_ms_avg_  {0.0}; ///< 프레임당 변환 시간 지수 이동 평균 (ms)
+    std::atomic<uint64_t> converted_frames_{0};   ///< 변환한 프레임 수
+    double                convert_ms_total_ = 0.0; ///< 누적 변환 시간 (ms)
+
+    // 텍스처 업로드 시간 (메인 스레드, convert_in_texture 면 변환 포함)
+    uint64_t              uploaded_frames_ = 0;
+    double                upload_ms_total_ = 0.0;
+    AVFrame*              lock_frame_      = nullptr; ///< 잠근 텍스처 메모리를 가리키는 sws 출력 프레임
 
     // 자막
     SubtitleTrack       subtitle_track_;   ///< 외부/내장 자막 저장소
@@ -223,11 +515,25 @@ private:
     bool                use_embedded_sub_ = false; ///< FFmpeg 내장 자막 사용 여부
 
     // 재생 상태
-    std::atomic<bool>   running_     {false}; ///< 디코딩 스레드 실행 중
+    std::atomic<bool>   running_     {false}; ///< 파이프라인 스레드 실행 중
     std::atomic<bool>   paused_      {false};
     std::atomic<bool>   ended_       {false};
     std::atomic<double> seek_target_ {-1.0};  ///< 탐색 목표 시간 (<0 이면 없음)
-    std::atomic<double> cur_pts_     {0.0};   ///< 현재 비디오 PTS (초)
+    std::atomic<int>    serial_      {0};     ///< seek 세대 (seek() 마다 증가)
+    std::atomic<int>    eof_serial_  {-1};    ///< 디코더가 EOF 까지 드레인한 세대
+    std::atomic<int>    shown_serial_{-1};    ///< update()가 마지막으로 프레임을 올린 세대
+    std::atomic<bool>   scrubbing_   {false}; ///< 진행바 드래그 미리보기 모드
+    std::atomic<bool>   seek_hold_   {false}; ///< seek 후 첫 프레임 표시 전: 클록/오디오 정지
+    std::atomic<Uint64> seek_req_ns_ {0};     ///< seek() 호출 시각 (첫 프레임 지연 측정)
+    std::atomic<uint64_t> preroll_dropped_{0}; ///< 현재 seek 의 선행 구간에서 디코딩만 하고 버린 프레임
+    uint64_t            seek_count_    = 0;   ///< 첫 프레임까지 측정한 seek 수 (메인 스레드)
+    double              seek_ms_total_ = 0.0;
+    double              seek_ms_last_  = 0.0;
+    std::atomic<bool>   hidden_      {false}; ///< 창이 보이지 않음: 비디오 패킷을 디코딩하지 않고 버림
+    std::atomic<uint64_t> hidden_skipped_{0}; ///< 숨김 동안 버린 비디오 패킷 (복원 시 0 으로)
+    Uint64              hidden_since_ns_ = 0; ///< 숨김 시작 시각 (메인 스레드)
+    std::atomic<double> scrub_target_{-1.0};  ///< 아직 처리 안 된 최신 scrub 목표 (<0 이면 없음)
+    std::atomic<double> cur_pts_     {0.0};   ///< 현재 표시 중인 비디오 PTS (초)
     std::atomic<float>  volume_      {1.0f};
     double              raw_duration_{0.0};   ///< AVFormatContext 기준 duration (AV_TIME_BASE 단위)
 };
@@ -269,6 +575,7 @@ public:
     bool   is_ended()     const override { return ended_;  }
 
     SDL_Texture* get_texture() const override;
+    void         release_textures() override { cleanup(); }
 
     bool is_valid()    const { return image_texture_ || !anim_frames_.empty(); }
     bool is_animated() const { return is_animated_; }
@@ -307,7 +614,15 @@ private:
 
 /**
  * @class AudioPlayer
- * @brief BASS 라이브러리 기반 오디오 재생, 외부 자막 지원
+ * @brief BASS 디코딩 채널 → 공유 AudioEngine 출력, 외부 자막 지원
+ *
+ *  BASS 는 파일 디코딩만 한다 (BASS_STREAM_DECODE, 출력 장치 없음). 디바이스가 요청하면
+ *  AudioEngine get 콜백이 BASS_ChannelGetData 로 필요한 만큼 float PCM 을 꺼내 이 플레이어의
+ *  SDL 스트림에 넣으므로, 비디오와 오디오가 같은 디바이스·같은 믹서로 나간다.
+ *
+ *  - 볼륨은 SDL 스트림 gain, 일시정지는 콜백이 데이터를 주지 않는 것으로.
+ *  - 위치 = 디코딩 위치 - (스트림에 남은 양 + 디바이스 지연).
+ *  - FFT 는 콜백이 내보낸 최근 샘플로 계산 (디코딩 채널에서 FFT 를 읽으면 데이터가 소모됨).
  *
  *  자막:
  *    - 생성자에서 외부 .srt/.ass 탐색
@@ -320,35 +635,82 @@ public:
      * @param volume   초기 볼륨 (0.0~1.0)
      */
     AudioPlayer(const std::wstring& filepath, float volume = 1.0f);
-    ~AudioPlayer() override { stop(); }
+    ~AudioPlayer() override;
 
-    void play()  override { song_.play(); }
-    void stop()  override { song_.stop(); }
+    void play()  override;
+    void stop()  override;
     bool update()override;
 
     void   toggle_pause()      override;
-    void   seek(double secs)   override { song_.seek(secs); }
-    void   set_volume(float v) override { song_.set_volume(v); }
-    double get_position() const override { return song_.get_position(); }
-    double get_length()   const override { return song_.get_length();   }
-    float  get_volume()   const override { return song_.get_volume();   }
-    bool   is_playing()   const override { return song_.is_playing();   }
-    bool   is_paused()    const override { return song_.is_paused();    }
-    bool   is_ended()     const override { return ended_.load();        }
-
-    bool get_fft(float* buf, int /*n*/) const override {
-        return const_cast<bass::Song&>(song_).get_fft(buf, BASS_DATA_FFT512);
-    }
+    void   seek(double secs)   override;
+    void   set_volume(float v) override;
+    double get_position() const override;
+    double get_length()   const override { return length_; }
+    float  get_volume()   const override { return volume_.load(); }
+    bool   is_playing()   const override { return playing_.load() && !paused_.load() && !ended_.load(); }
+    bool   is_paused()    const override { return paused_.load(); }
+    bool   is_ended()     const override { return ended_.load(); }
+
+    bool get_fft(float* buf, int n) const override;
     std::string get_subtitle_text() const override {
-        return subtitle_track_.get_active(song_.get_position());
+        return subtitle_track_.get_active(get_position());
     }
 
-    bool is_valid()  const { return song_.is_valid(); }
-    void restart()         { song_.play(true); ended_ = false; was_playing_ = false; }
+    bool is_valid()  const { return decode_ != 0 && stream_ != nullptr; }
+    void restart()         { seek(0.0); ended_ = false; play(); }
+
+    /**
+     * @brief 볼륨을 secs 초 동안 target 으로 (update() 에서 진행, 크로스페이드용)
+     *
+     *  equal-power 곡선: 올릴 때 sin, 내릴 때 1 - cos – 두 곡을 겹쳐도 합친 음량이 일정.
+     *  secs <= 0 이면 바로 적용.
+     */
+    void fade_to(float target, double secs);
+
+    /**
+     * @brief gapless: 이 곡 디코딩이 끝나는 순간 콜백 안에서 next 를 이어 재생
+     *
+     *  형식(채널·레이트)이 같으면 마지막 요청의 남은 부분을 next 의 앞부분으로 채워
+     *  샘플 단위로 잇고, 다르면 그 시점에 next 를 재생 상태로만 바꾼다.
+     *  next 는 play() 하지 않은 채로 넘기며, 이 플레이어보다 먼저 해제하면 안 된다.
+     *  이어 붙이기 전에 이 플레이어가 해제되면 소멸자에서 next 를 시작한다 (nullptr 로 취소).
+     */
+    void queue_next(AudioPlayer* next) { next_ = next; }
 
 private:
-    bass::Song        song_;               ///< BASS 노래 객체
+    static void SDLCALL audio_callback(void* userdata, SDL_AudioStream* stream,
+                                       int additional, int total);
+    void feed_audio(SDL_AudioStream* stream, int need);   ///< 디바이스 스레드
+    void hand_over(SDL_AudioStream* stream, int need, AudioPlayer& next);   ///< queue_next() 이어 붙이기
+
+    /// 디코딩 채널에서 최대 bytes 만큼 읽기 (decode_mutex_ 아래, 끝이면 decode_ended_)
+    int  decode(uint8_t* dst, int bytes);
+    void push_scope(const float* samples, int frames);    ///< FFT 용 최근 샘플 기록 (모노)
+
+    static constexpr int FFT_SIZE = 512;   ///< get_fft() 입력 샘플 수 (출력 FFT_SIZE / 2)
+
+    HSTREAM           decode_      = 0;        ///< BASS 디코딩 채널 (float)
+    SDL_AudioStream*  stream_      = nullptr;  ///< AudioEngine 디바이스에 연결한 스트림
+    SDL_AudioSpec     spec_        {};         ///< 디코딩 채널 형식 (F32, 채널, 레이트)
+    int               frame_bytes_ = 0;        ///< 샘플 프레임(전 채널) 바이트
+    double            length_      = 0.0;      ///< 길이 (초)
+    double            device_latency_ = 0.0;   ///< 디바이스 버퍼 지연 (초)
+
+    mutable std::mutex decode_mutex_;          ///< decode_ 위치 (콜백 ↔ seek/위치 조회)
+    std::atomic<bool>  playing_      {false};  ///< play() 이후 (stop() 전까지)
+    std::atomic<bool>  paused_       {false};
+    std::atomic<bool>  decode_ended_ {false};  ///< 디코딩 채널이 끝까지 읽힘
+    std::atomic<float> volume_       {1.0f};
+    std::atomic<AudioPlayer*> next_  {nullptr};   ///< 끝나면 이어 재생할 곡 (queue_next)
+
+    mutable std::mutex scope_mutex_;           ///< scope_ (콜백 ↔ get_fft)
+    float              scope_[FFT_SIZE] {};    ///< 최근 출력 샘플 (모노, 링)
+    int                scope_pos_ = 0;
+
+    float             fade_from_  = 0.0f;  ///< 볼륨 램프 시작 값
+    float             fade_to_    = 0.0f;  ///< 볼륨 램프 목표 값
+    Uint64            fade_t0_    = 0;     ///< 램프 시작 시각 (ns)
+    Uint64            fade_ns_    = 0;     ///< 램프 길이 (0 = 진행 중인 램프 없음)
     SubtitleTrack     subtitle_track_;     ///< 외부 자막 저장소
     std::atomic<bool> ended_      {false}; ///< 재생 종료 플래그 (update에서 감지)
-    bool              was_playing_{false}; ///< 이전 프레임에서 재생 중이었는지 (종료 감지용)
 };
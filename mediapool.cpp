@@ -0,0 +1,158 @@
+/**
+ * @file mediapool.cpp
+ * @brief PacketPool / FrameBufferPool 구현
+ */
+
+#include "mediapool.h"
+
+extern "C" {
+#include <libavutil/imgutils.h>
+}
+
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+// ── PacketPool ────────────────────────────────────────────────────
+
+PacketPool::~PacketPool() {
+    for (auto* p : free_) av_packet_free(&p);
+}
+
+AVPacket* PacketPool::get() {
+    if (!free_.empty()) {
+        AVPacket* p = free_.back();
+        free_.pop_back();
+        ++stats_.reuses;
+        return p;
+    }
+    ++stats_.allocs;
+    return av_packet_alloc();
+}
+
+void PacketPool::put(AVPacket* pkt) {
+    if (!pkt) return;
+    av_packet_unref(pkt);
+    free_.push_back(pkt);
+}
+
+// ── FrameBufferPool ───────────────────────────────────────────────
+
+static constexpr size_t HUGE_PAGE_SIZE = 2u * 1024 * 1024;
+
+/// alloc_buffer() 로 할당한 메모리 해제 (풀 객체와 무관하게 호출될 수 있음)
+static void free_aligned(void*, uint8_t* data) {
+#ifdef _WIN32
+    _aligned_free(data);
+#else
+    std::free(data);
+#endif
+}
+
+FrameBufferPool::FrameBufferPool(bool huge_pages)
+    : huge_pages_(huge_pages)
+{
+}
+
+FrameBufferPool::~FrameBufferPool() {
+    av_buffer_pool_uninit(&pool_);   // 사용 중인 버퍼는 마지막 unref 시 해제
+}
+
+/**
+ * @brief AVBufferPool 할당 콜백 – 풀이 비었을 때만 불린다
+ *
+ *  huge page 요청 시 2MB 이상 버퍼는 2MB 경계로 할당하고 THP 를 권고한다
+ *  (Windows 대형 페이지는 권한이 필요하므로 일반 정렬 할당으로 대신함).
+ */
+AVBufferRef* FrameBufferPool::alloc_buffer(void* opaque, size_t size) {
+    auto* self = static_cast<FrameBufferPool*>(opaque);
+
+    size_t align = ALIGN;
+    size_t bytes = size;
+#ifdef __linux__
+    if (self->huge_pages_ && size >= HUGE_PAGE_SIZE) {
+        align = HUGE_PAGE_SIZE;
+        bytes = (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    }
+#endif
+
+    void* data = nullptr;
+#ifdef _WIN32
+    data = _aligned_malloc(bytes, align);
+#else
+    if (posix_memalign(&data, align, bytes) != 0) data = nullptr;
+#endif
+    if (!data) return nullptr;
+
+#ifdef __linux__
+    if (align == HUGE_PAGE_SIZE) madvise(data, bytes, MADV_HUGEPAGE);
+#endif
+
+    AVBufferRef* ref = av_buffer_create(static_cast<uint8_t*>(data), size,
+                                        free_aligned, nullptr, 0);
+    if (!ref) { free_aligned(nullptr, static_cast<uint8_t*>(data)); return nullptr; }
+
+    ++self->allocs_;
+    return ref;
+}
+
+/**
+ * @brief 크기/포맷이 바뀌었으면 풀을 새로 만든다
+ */
+bool FrameBufferPool::ensure_pool(int width, int height, AVPixelFormat fmt) {
+    if (pool_ && width == width_ && height == height_ && fmt == fmt_) return true;
+
+    const int size = av_image_get_buffer_size(fmt, width, height, ALIGN);
+    if (size <= 0) return false;
+
+    av_buffer_pool_uninit(&pool_);
+    // 마지막 평면 끝을 넘어 읽는 SIMD 를 위해 ALIGN 만큼 여유
+    buf_size_ = static_cast<size_t>(size) + ALIGN;
+    pool_     = av_buffer_pool_init2(buf_size_, this, alloc_buffer, nullptr);
+    width_    = width;
+    height_   = height;
+    fmt_      = fmt;
+    return pool_ != nullptr;
+}
+
+bool FrameBufferPool::get(AVFrame* frame, int width, int height, AVPixelFormat fmt) {
+    av_frame_unref(frame);
+    if (!ensure_pool(width, height, fmt)) return false;
+
+    const uint64_t before = allocs_.load();
+    AVBufferRef*   buf    = av_buffer_pool_get(pool_);
+    if (!buf) return false;
+    if (allocs_.load() == before) ++reuses_;
+
+    if (av_image_fill_arrays(frame->data, frame->linesize, buf->data,
+                             fmt, width, height, ALIGN) < 0) {
+        av_buffer_unref(&buf);
+        return false;
+    }
+    frame->buf[0] = buf;
+    frame->format = fmt;
+    frame->width  = width;
+    frame->height = height;
+    return true;
+}
+
+bool FrameBufferPool::reserve(int count, int width, int height, AVPixelFormat fmt) {
+    if (!ensure_pool(width, height, fmt)) return false;
+
+    // 한꺼번에 꺼냈다가 돌려주면 풀에 count 개가 남는다
+    std::vector<AVBufferRef*> bufs;
+    bufs.reserve(static_cast<size_t>(count));
+    bool ok = true;
+    for (int i = 0; i < count; ++i) {
+        AVBufferRef* b = av_buffer_pool_get(pool_);
+        if (!b) { ok = false; break; }
+        bufs.push_back(b);
+    }
+    for (auto* b : bufs) av_buffer_unref(&b);
+    return ok;
+}
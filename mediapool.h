@@ -0,0 +1,109 @@
+#pragma once
+
+/**
+ * @file mediapool.h
+ * @brief 디코딩 파이프라인용 재사용 풀 (AVPacket 껍데기 / 정렬된 프레임 버퍼)
+ *
+ *  풀이 맡는 할당은 재생이 안정 상태에 들어가면 더 없어야 한다. 각 풀은 새로 할당한 수와
+ *  재사용한 수를 세므로, 워밍업 이후 allocs 가 늘지 않는 것으로 확인할 수 있다.
+ *  (패킷 데이터는 av_read_frame 이 패킷마다 할당하므로 여기서 다루지도, 세지도 않는다.)
+ *
+ *  - PacketPool      : PacketQueue 가 큐에 넣을 때마다 쓰던 av_packet_alloc/free 대체
+ *  - FrameBufferPool : sws 변환 대상 프레임 버퍼 (64바이트 정렬, 선택적 huge page)
+ *
+ *  디코더 출력 프레임은 FFmpeg 내부 버퍼 풀을, 표시 대기 프레임은 FrameRing 슬롯을
+ *  그대로 재사용하므로 별도 AVFrame 풀은 두지 않는다.
+ */
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/buffer.h>
+#include <libavutil/frame.h>
+}
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/// 풀 사용 통계
+struct PoolStats {
+    uint64_t allocs = 0;   ///< 풀이 비어 새로 할당한 수
+    uint64_t reuses = 0;   ///< 풀에서 꺼내 재사용한 수
+};
+
+/**
+ * @class PacketPool
+ * @brief AVPacket 껍데기(구조체) 재사용 목록
+ *
+ *  스레드 안전하지 않다 – 소유자(PacketQueue)가 자기 mutex 아래에서 호출한다.
+ *  패킷 데이터 버퍼는 디먹서가 할당하므로 대상이 아니다.
+ */
+class PacketPool {
+public:
+    PacketPool() = default;
+    ~PacketPool();
+
+    PacketPool(const PacketPool&)            = delete;
+    PacketPool& operator=(const PacketPool&) = delete;
+
+    /// @brief 빈 패킷 (목록이 비었으면 새로 할당, 실패 시 nullptr)
+    AVPacket* get();
+    /// @brief 패킷을 unref 하여 목록에 반환
+    void      put(AVPacket* pkt);
+
+    PoolStats stats() const { return stats_; }
+
+private:
+    std::vector<AVPacket*> free_;
+    PoolStats              stats_;
+};
+
+/**
+ * @class FrameBufferPool
+ * @brief 한 가지 크기/포맷의 프레임 버퍼 풀 (AVBufferPool + 정렬 할당자)
+ *
+ *  get() 의 크기/포맷이 바뀌면(창 크기 변경 등) 풀을 새로 만든다. 이전 풀의 버퍼는
+ *  마지막 참조가 풀릴 때 해제된다. get() 은 한 스레드(비디오 디코딩)에서만 호출한다.
+ */
+class FrameBufferPool {
+public:
+    /// @param huge_pages 큰 버퍼를 2MB 정렬로 할당하고 huge page 사용을 요청 (Linux THP)
+    explicit FrameBufferPool(bool huge_pages = false);
+    ~FrameBufferPool();
+
+    FrameBufferPool(const FrameBufferPool&)            = delete;
+    FrameBufferPool& operator=(const FrameBufferPool&) = delete;
+
+    void set_huge_pages(bool on) { huge_pages_ = on; }
+
+    /**
+     * @brief frame 을 unref 하고 풀 버퍼를 붙여 width x height, fmt 프레임으로 만든다
+     * @return 할당 실패 시 false
+     */
+    bool get(AVFrame* frame, int width, int height, AVPixelFormat fmt);
+
+    /// @brief count 개를 미리 할당해 풀에 채워 둔다 (실제 변환 대상 크기/포맷 기준 워밍업)
+    bool reserve(int count, int width, int height, AVPixelFormat fmt);
+
+    /// @brief 풀이 이미 width x height, fmt 버퍼용인지 (get() 과 같은 스레드에서)
+    bool matches(int width, int height, AVPixelFormat fmt) const {
+        return pool_ && width == width_ && height == height_ && fmt == fmt_;
+    }
+
+    PoolStats stats() const { return { allocs_.load(), reuses_.load() }; }
+
+private:
+    static constexpr int ALIGN = 64;   ///< 평면/행 정렬 (AVX-512 캐시 라인)
+
+    bool ensure_pool(int width, int height, AVPixelFormat fmt);
+    static AVBufferRef* alloc_buffer(void* opaque, size_t size);
+
+    AVBufferPool*         pool_       = nullptr;
+    size_t                buf_size_   = 0;
+    int                   width_      = 0;
+    int                   height_     = 0;
+    AVPixelFormat         fmt_        = AV_PIX_FMT_NONE;
+    bool                  huge_pages_ = false;
+    std::atomic<uint64_t> allocs_     {0};
+    std::atomic<uint64_t> reuses_     {0};
+};
@@ -75,11 +75,16 @@ float BaseRenderer::x_to_progress(float mouse_x) const {
 
 /**
  * @brief 진행률(0.0~1.0)에 따라 플레이어 탐색 (정적 유틸)
+ * @param scrub true 면 드래그 미리보기 – 가까운 키프레임으로 붙여 scrub(),
+ *              false 면 정확한 seek()
  */
-void BaseRenderer::seek_to_progress(MediaPlayer* player, float progress) {
+void BaseRenderer::seek_to_progress(MediaPlayer* player, float progress, bool scrub) {
     if (!player) return;
     const double len = player->get_length();
-    if (len > 0.0) player->seek(len * static_cast<double>(progress));
+    if (len <= 0.0) return;
+    const double secs = len * static_cast<double>(progress);
+    if (scrub) player->scrub(player->snap_to_keyframe(secs));
+    else       player->seek(secs);
 }
 
 // ════════════════════════════════════════════════════════════════════
@@ -126,6 +131,7 @@ MediaRenderer::MediaRenderer(const std::string& title,
 MediaRenderer::~MediaRenderer() {
     if (sub_texture_) SDL_DestroyTexture(sub_texture_);
     if (osd_texture_) SDL_DestroyTexture(osd_texture_);
+    if (thumb_texture_) SDL_DestroyTexture(thumb_texture_);
     if (font_)        TTF_CloseFont(font_);
     TTF_Quit();
     if (renderer_)    SDL_DestroyRenderer(renderer_);
@@ -372,10 +378,11 @@ void MediaRenderer::render_subtitle(const std::string& text) const {
 /**
  * @brief OSD(On-Screen Display) – 좌상단에 재생 정보를 표시합니다.
  *
- *  표시 내용 (3줄):
+ *  표시 내용 (3~4줄):
  *    파일명 (확장자 제외, 최대 60자)
  *    시간: MM:SS / MM:SS
  *    볼륨: XX%   일시정지 시 [일시정지] 추가
+ *    진단 정보 (player->get_debug_info(), 있을 때만)
  */
 void MediaRenderer::render_osd(MediaPlayer* player,
                                 const std::string& filename) const {
@@ -395,13 +402,16 @@ void MediaRenderer::render_osd(MediaPlayer* player,
     std::string vol_str = "볼륨: " + std::to_string(vol) + "%";
     if (player->is_paused()) vol_str += "  [일시정지]";
 
-    const std::string osd_text = disp_name + '\n' + time_str + '\n' + vol_str;
+    const std::string dbg_str  = player->get_debug_info();
+    const std::string osd_text = disp_name + '\n' + time_str + '\n' + vol_str
+                               + '\n' + dbg_str;
 
     if (osd_text != osd_text_cached_) {
         if (osd_texture_) { SDL_DestroyTexture(osd_texture_); osd_texture_ = nullptr; }
         osd_text_cached_ = osd_text;
 
         std::vector<std::string> lines = { disp_name, time_str, vol_str };
+        if (!dbg_str.empty()) lines.push_back(dbg_str);
         SDL_Color fg = {220, 220, 220, 255};
         std::vector<SDL_Surface*> surfs;
         int total_h = 0, max_w = 0;
@@ -457,10 +467,57 @@ void MediaRenderer::render_osd(MediaPlayer* player,
     SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_NONE);
 }
 
+/**
+ * @brief 진행바 위에 마우스가 있으면 그 위치의 썸네일을 바 바로 위에 표시
+ *
+ *  Thumbnailer::request() 는 블로킹하지 않으므로 아직 생성되지 않은 위치는
+ *  이번 프레임에 그리지 않고 넘어간다 (다음 프레임에 캐시에서 나옴).
+ */
+void MediaRenderer::render_thumbnail(double len) {
+    if (!thumbnailer_ || thumb_path_.empty() || len <= 0.0) return;
+    if (SDL_GetMouseFocus() != window_) return;
+
+    float mx, my;
+    SDL_GetMouseState(&mx, &my);
+    if (!is_over_bar(my)) return;
+
+    auto thumb = thumbnailer_->request(thumb_path_, x_to_progress(mx) * len);
+    if (!thumb || thumb->rgba.empty()) return;
+
+    if (thumb != thumb_shown_ || !thumb_texture_) {
+        if (!thumb_texture_ || thumb->width  != thumb_shown_->width
+                            || thumb->height != thumb_shown_->height) {
+            if (thumb_texture_) SDL_DestroyTexture(thumb_texture_);
+            thumb_texture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32,
+                                               SDL_TEXTUREACCESS_STATIC,
+                                               thumb->width, thumb->height);
+            if (!thumb_texture_) return;
+        }
+        SDL_UpdateTexture(thumb_texture_, nullptr, thumb->rgba.data(), thumb->width * 4);
+        thumb_shown_ = thumb;
+    }
+
+    int win_w, win_h;
+    SDL_GetWindowSize(window_, &win_w, &win_h);
+
+    constexpr float BORDER = 2.0f;
+    const float tw = static_cast<float>(thumb->width);
+    const float th = static_cast<float>(thumb->height);
+    const float x  = SDL_clamp(mx - tw * 0.5f, BORDER, static_cast<float>(win_w) - tw - BORDER);
+    const float y  = static_cast<float>(win_h) - BAR_H - BAR_MARGIN - HIT_MARGIN - th - BORDER;
+
+    SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
+    SDL_FRect frame = { x - BORDER, y - BORDER, tw + BORDER * 2, th + BORDER * 2 };
+    SDL_RenderFillRect(renderer_, &frame);
+
+    SDL_FRect dst = { x, y, tw, th };
+    SDL_RenderTexture(renderer_, thumb_texture_, nullptr, &dst);
+}
+
 // ── 공개 render() ────────────────────────────────────────────────
 
 /**
- * @brief 최종 렌더링: 배경 클리어 → 미디어 → 자막 → 진행바 → OSD
+ * @brief 최종 렌더링: 배경 클리어 → 미디어 → 자막 → 진행바 → 썸네일 → OSD
  */
 void MediaRenderer::render(MediaPlayer* player,
                             const std::string& filename,
@@ -469,6 +526,8 @@ void MediaRenderer::render(MediaPlayer* player,
     SDL_RenderClear(renderer_);
 
     if (!player) {
+        // 백그라운드에서 여는 동안에도 이벤트/렌더링은 계속 – 안내 문구만 표시
+        if (!loading_name_.empty()) render_subtitle("불러오는 중... " + loading_name_);
         SDL_RenderPresent(renderer_);
         return;
     }
@@ -483,7 +542,10 @@ void MediaRenderer::render(MediaPlayer* player,
     const std::string sub = player->get_subtitle_text();
     if (!sub.empty()) render_subtitle(sub);
 
-    if (len > 0.0) render_progress_bar(progress, bar_dragging);
+    if (len > 0.0) {
+        render_progress_bar(progress, bar_dragging);
+        render_thumbnail(len);
+    }
 
     if (osd_enabled_) render_osd(player, filename);
 
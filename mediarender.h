@@ -22,6 +22,7 @@
 #include <glad/glad.h>
 #include "mediaplayer.h"
 #include "subtitle.h"
+#include "thumbnailer.h"
 
 
 // ──────────────────────────────────────────────────────────────────
@@ -124,7 +125,7 @@ public:
     SDL_Window* get_window() const override { return window_; }
 
     /// @brief 진행률(0.0~1.0)로 플레이어 탐색 수행 (공통 유틸)
-    static void seek_to_progress(MediaPlayer* player, float progress);
+    static void seek_to_progress(MediaPlayer* player, float progress, bool scrub = false);
 
 protected:
     SDL_Window* window_     = nullptr;
@@ -147,6 +148,7 @@ protected:
  *    get_length()  > 0        → 하단 진행바
  *    get_subtitle_text() != ""→ 자막 오버레이 (진행바 바로 위)
  *    osd_enabled_             → 좌상단 정보 오버레이
+ *    진행바 위 마우스 호버    → 해당 위치 썸네일 (set_thumbnail_source() 설정 시)
  */
 class MediaRenderer : public BaseRenderer {
 public:
@@ -182,6 +184,13 @@ public:
         return "unknown";
     }
 
+    /// @brief 호버 썸네일 생성기 지정 (nullptr = 기능 끔, 소유권 없음)
+    void set_thumbnailer(Thumbnailer* thumbs) { thumbnailer_ = thumbs; }
+    /// @brief 호버 썸네일 대상 파일 (UTF-8, 비디오가 아니면 빈 문자열)
+    void set_thumbnail_source(const std::string& path) { thumb_path_ = path; }
+    /// @brief 플레이어를 여는 중이면 파일명 (UTF-8), 플레이어가 없을 때 안내 문구로 표시. 빈 문자열 = 끔
+    void set_loading(const std::string& name) { loading_name_ = name; }
+
 private:
     // ── 초기화 헬퍼 ─────────────────────────────────────────────
     void load_font(const std::string& font_path, int font_size);
@@ -193,6 +202,7 @@ private:
     void render_fft(MediaPlayer* player) const;
     void render_subtitle(const std::string& text) const;
     void render_osd(MediaPlayer* player, const std::string& filename) const;
+    void render_thumbnail(double len);
 
     // ── SDL 렌더러 ───────────────────────────────────────────────
     SDL_Renderer* renderer_  = nullptr;
@@ -213,6 +223,14 @@ private:
     mutable std::string  osd_text_cached_;
     mutable int          osd_tex_w_        = 0;
     mutable int          osd_tex_h_        = 0;
+
+    // ── 호버 썸네일 (마지막으로 올린 이미지만 텍스처로 보관) ──────
+    Thumbnailer*                     thumbnailer_   = nullptr;
+    std::string                      thumb_path_;
+    std::shared_ptr<const Thumbnail> thumb_shown_;   ///< thumb_texture_ 의 원본
+    SDL_Texture*                     thumb_texture_ = nullptr;
+
+    std::string loading_name_;   ///< 비동기로 여는 중인 파일 (set_loading)
 };
 
 
@@ -0,0 +1,144 @@
+/**
+ * @file packetqueue.cpp
+ * @brief PacketQueue 구현
+ */
+
+#include "packetqueue.h"
+
+PacketQueue::PacketQueue(size_t max_bytes, size_t max_packets)
+    : items_(max_packets + 2),   // + 플러시 마커, is_full() 확인 전 한 개
+      max_bytes_(max_bytes), max_packets_(max_packets)
+{
+}
+
+PacketQueue::~PacketQueue() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    clear_locked();
+}
+
+/**
+ * @brief 큐에 남은 패킷을 모두 해제 (mutex_ 보유 상태에서 호출)
+ */
+void PacketQueue::clear_locked() {
+    for (size_t i = 0; i < count_; ++i) {
+        Item& it = items_[(head_ + i) % items_.size()];
+        if (it.pkt) pool_.put(it.pkt);
+    }
+    head_         = 0;
+    count_        = 0;
+    bytes_        = 0;
+    packet_count_ = 0;
+}
+
+void PacketQueue::push_item(const Item& it) {
+    if (count_ == items_.size()) {
+        // 디먹서는 모든 큐가 찰 때까지 읽으므로 한 큐가 max_packets 를 넘을 수 있다
+        std::vector<Item> grown(items_.size() * 2);
+        for (size_t i = 0; i < count_; ++i)
+            grown[i] = items_[(head_ + i) % items_.size()];
+        items_.swap(grown);
+        head_ = 0;
+        ++grows_;
+    }
+    items_[(head_ + count_) % items_.size()] = it;
+    ++count_;
+}
+
+bool PacketQueue::push(AVPacket* pkt) {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (aborted_) return false;
+
+        AVPacket* copy = pool_.get();
+        if (!copy) return false;
+        av_packet_move_ref(copy, pkt);
+        bytes_ += static_cast<size_t>(copy->size);
+        ++packet_count_;
+        push_item({ copy, 0.0, 0 });
+    }
+    cv_.notify_one();
+    return true;
+}
+
+void PacketQueue::flush(double pos, int serial) {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        clear_locked();
+        eof_ = false;
+        push_item({ nullptr, pos, serial });
+    }
+    cv_.notify_one();
+}
+
+void PacketQueue::set_eof() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        eof_ = true;
+    }
+    cv_.notify_one();
+}
+
+PacketQueue::PopResult PacketQueue::pop(AVPacket* out, double* flush_pos,
+                                        int* flush_serial) {
+    std::unique_lock<std::mutex> lk(mutex_);
+    cv_.wait(lk, [&] { return aborted_ || count_ > 0 || eof_; });
+
+    if (aborted_) return PopResult::Aborted;
+
+    if (count_ == 0) {
+        // eof_ 는 한 번만 통지 – 이후 pop()은 다음 패킷(seek 후)까지 블로킹
+        eof_ = false;
+        return PopResult::Eof;
+    }
+
+    const Item it = items_[head_];
+    head_ = (head_ + 1) % items_.size();
+    --count_;
+
+    if (!it.pkt) {
+        if (flush_pos)    *flush_pos    = it.pos;
+        if (flush_serial) *flush_serial = it.serial;
+        return PopResult::Flush;
+    }
+
+    bytes_ -= static_cast<size_t>(it.pkt->size);
+    --packet_count_;
+    av_packet_move_ref(out, it.pkt);
+    pool_.put(it.pkt);
+    return PopResult::Packet;
+}
+
+void PacketQueue::abort() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        aborted_ = true;
+    }
+    cv_.notify_all();
+}
+
+void PacketQueue::start() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    aborted_ = false;
+}
+
+bool PacketQueue::is_full() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return bytes_ >= max_bytes_ || packet_count_ >= max_packets_;
+}
+
+size_t PacketQueue::bytes() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return bytes_;
+}
+
+size_t PacketQueue::packets() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return packet_count_;
+}
+
+PoolStats PacketQueue::pool_stats() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    PoolStats s = pool_.stats();
+    s.allocs += grows_;
+    return s;
+}
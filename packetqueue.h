@@ -0,0 +1,117 @@
+#pragma once
+
+/**
+ * @file packetqueue.h
+ * @brief 디먹스 스레드 → 디코더 스레드 간 AVPacket 전달 큐
+ *
+ *  VideoPlayer 파이프라인:
+ *    demux_loop ─┬─▶ video PacketQueue ─▶ video_decode_loop
+ *                └─▶ audio PacketQueue ─▶ audio_decode_loop
+ *
+ *  - push() 는 블로킹하지 않는다. 용량 판단(is_full)은 디먹서가 모든 큐를 보고
+ *    결정한다. 한 스트림 큐가 찼다고 디먹스를 멈추면 다른 스트림이 굶기 때문.
+ *  - seek 시 flush(pos) 로 대기 중인 패킷을 버리고 플러시 마커를 넣는다.
+ *    디코더는 마커를 받으면 avcodec_flush_buffers 후 새 serial 로 프레임을 내보낸다.
+ *  - EOF 는 set_eof() 로 알리며, 큐가 빈 뒤 pop() 이 한 번만 Eof 를 반환한다.
+ *  - 큐 항목용 AVPacket 껍데기는 PacketPool 에서 재사용하고, 항목은 고정 크기 링에 담는다
+ *    (deque 처럼 노드를 할당/해제하지 않음). 링은 max_packets 기준으로 잡고, 디먹서가
+ *    다른 큐를 채우느라 넘치게 밀어 넣으면 두 배로 늘린다 (pool_stats() 의 할당에 포함).
+ *  - 패킷 데이터(페이로드)는 av_read_frame 이 패킷마다 할당하므로 풀/통계 대상이 아니다.
+ */
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "mediapool.h"
+
+/**
+ * @class PacketQueue
+ * @brief 스레드 안전 AVPacket FIFO (플러시 마커 / EOF / abort 지원)
+ */
+class PacketQueue {
+public:
+    /// pop() 결과
+    enum class PopResult {
+        Packet,   ///< out 에 패킷이 채워짐
+        Flush,    ///< seek 플러시 마커 (flush_pos 에 목표 시간)
+        Eof,      ///< 디먹서가 EOF 에 도달했고 큐가 비었음 (1회 통지)
+        Aborted,  ///< abort() 호출됨 – 스레드 종료
+    };
+
+    /**
+     * @param max_bytes   이 바이트 수 이상 쌓이면 is_full()
+     * @param max_packets 이 패킷 수 이상 쌓이면 is_full()
+     */
+    PacketQueue(size_t max_bytes, size_t max_packets);
+    ~PacketQueue();
+
+    PacketQueue(const PacketQueue&)            = delete;
+    PacketQueue& operator=(const PacketQueue&) = delete;
+
+    /**
+     * @brief 패킷 참조를 큐로 이동 (pkt 는 빈 패킷이 됨)
+     * @return abort 상태면 false (pkt 는 그대로 남음)
+     */
+    bool push(AVPacket* pkt);
+
+    /**
+     * @brief 대기 중인 패킷을 모두 버리고 플러시 마커 삽입, EOF 상태 해제
+     * @param pos    seek 목표 시간 (초)
+     * @param serial seek 세대 – 디코더가 이후 프레임에 부착
+     */
+    void flush(double pos, int serial);
+
+    /// @brief 디먹서 EOF 통지 (큐가 비면 pop()이 Eof 반환)
+    void set_eof();
+
+    /**
+     * @brief 다음 항목을 꺼낸다. 비어 있으면 블로킹
+     * @param out          Packet 일 때 참조가 이동될 패킷
+     * @param flush_pos    Flush 일 때 seek 목표 시간 (nullptr 허용)
+     * @param flush_serial Flush 일 때 seek 세대 (nullptr 허용)
+     */
+    PopResult pop(AVPacket* out, double* flush_pos = nullptr,
+                  int* flush_serial = nullptr);
+
+    /// @brief 대기 중인 모든 pop() 을 깨우고 이후 호출을 Aborted 로 만든다
+    void abort();
+    /// @brief abort 상태 해제 (play() 재호출 시)
+    void start();
+
+    bool   is_full() const;
+    size_t bytes()   const;
+    size_t packets() const;
+    PoolStats pool_stats() const;   ///< 패킷 껍데기 할당/재사용 수 (+ 항목 링 확장 수)
+
+private:
+    struct Item {
+        AVPacket* pkt;    ///< 플러시 마커면 nullptr
+        double    pos;    ///< 플러시 마커의 seek 목표 시간
+        int       serial; ///< 플러시 마커의 seek 세대
+    };
+
+    void clear_locked();
+    void push_item(const Item& it);   ///< 링 끝에 추가, 가득 차면 두 배로 (mutex_ 아래)
+
+    std::vector<Item>       items_;       ///< 항목 링 (head_ 부터 count_ 개)
+    size_t                  head_  = 0;
+    size_t                  count_ = 0;
+    uint64_t                grows_ = 0;   ///< 링 확장 (재할당) 수
+    PacketPool              pool_;     ///< 항목 패킷 껍데기 (mutex_ 보호)
+    mutable std::mutex      mutex_;
+    std::condition_variable cv_;
+
+    size_t bytes_        = 0;
+    size_t packet_count_ = 0;
+    size_t max_bytes_;
+    size_t max_packets_;
+    bool   eof_          = false;
+    bool   aborted_      = false;
+};
@@ -0,0 +1,64 @@
+/**
+ * @file pcmring.cpp
+ * @brief PcmRing 구현
+ */
+
+#include "pcmring.h"
+
+#include <algorithm>
+#include <cstring>
+
+void PcmRing::reset(size_t capacity) {
+    buf_.assign(capacity, 0);
+    read_  = 0;
+    write_ = 0;
+}
+
+size_t PcmRing::write(const uint8_t* src, size_t n) {
+    if (buf_.empty()) return 0;
+    const uint64_t w = write_.load(std::memory_order_relaxed);
+    const uint64_t r = read_.load(std::memory_order_acquire);
+    n = std::min(n, buf_.size() - static_cast<size_t>(w - r));
+    if (n == 0) return 0;
+
+    const size_t idx   = static_cast<size_t>(w % buf_.size());
+    const size_t first = std::min(n, buf_.size() - idx);
+    std::memcpy(buf_.data() + idx, src, first);
+    std::memcpy(buf_.data(), src + first, n - first);
+    write_.store(w + n, std::memory_order_release);
+    return n;
+}
+
+size_t PcmRing::read(uint8_t* dst, size_t n) {
+    if (buf_.empty()) return 0;
+    uint64_t r = read_.load(std::memory_order_acquire);
+    for (;;) {
+        const uint64_t w    = write_.load(std::memory_order_acquire);
+        const size_t   take = std::min(n, static_cast<size_t>(w - r));
+        if (take == 0) return 0;
+
+        copy_out(r, dst, take);
+        // 복사하는 사이 discard() 가 있었으면 r 이 갱신되고 다시 읽는다
+        if (read_.compare_exchange_strong(r, r + take, std::memory_order_acq_rel))
+            return take;
+    }
+}
+
+void PcmRing::discard() {
+    const uint64_t w = write_.load(std::memory_order_relaxed);
+    uint64_t       r = read_.load(std::memory_order_acquire);
+    while (r < w && !read_.compare_exchange_weak(r, w, std::memory_order_acq_rel)) {}
+}
+
+size_t PcmRing::size() const {
+    const uint64_t r = read_.load(std::memory_order_acquire);
+    const uint64_t w = write_.load(std::memory_order_acquire);
+    return w > r ? static_cast<size_t>(w - r) : 0;
+}
+
+void PcmRing::copy_out(uint64_t pos, uint8_t* dst, size_t n) const {
+    const size_t idx   = static_cast<size_t>(pos % buf_.size());
+    const size_t first = std::min(n, buf_.size() - idx);
+    std::memcpy(dst, buf_.data() + idx, first);
+    std::memcpy(dst + first, buf_.data(), n - first);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * @file pcmring.h
+ * @brief 오디오 디코딩 스레드 → SDL 오디오 콜백 간 PCM 바이트 링 버퍼 (락 없음)
+ *
+ *  단일 생산자(오디오 디코딩 스레드) / 단일 소비자(SDL 오디오 스트림 get 콜백).
+ *  콜백은 디바이스 스레드에서 불리므로 락/할당 없이 읽기 위치만 원자적으로 옮긴다.
+ *
+ *  - 위치는 누적 바이트 수(64비트)로 관리하고 링 인덱스는 capacity 로 나눈 나머지.
+ *  - discard() (seek 플러시) 는 생산자가 읽기 위치를 쓰기 위치로 당긴다.
+ *    그 순간 복사 중이던 소비자는 CAS 실패로 복사본을 버리고 다시 읽으므로
+ *    이전 세대 샘플이나 덮어쓰인 바이트가 출력되지 않는다.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class PcmRing
+ * @brief 고정 크기 바이트 링 (생산자 1 / 소비자 1)
+ */
+class PcmRing {
+public:
+    PcmRing() = default;
+
+    PcmRing(const PcmRing&)            = delete;
+    PcmRing& operator=(const PcmRing&) = delete;
+
+    /// @brief 버퍼 할당 (생산자/소비자가 모두 멈춰 있을 때만)
+    void   reset(size_t capacity);
+
+    /**
+     * @brief 생산자: 남은 공간만큼 기록
+     * @return 기록한 바이트 (공간이 모자라면 n 보다 작음)
+     */
+    size_t write(const uint8_t* src, size_t n);
+
+    /**
+     * @brief 소비자: 최대 n 바이트 읽기
+     * @return 읽은 바이트 (링이 비어 있으면 0)
+     */
+    size_t read(uint8_t* dst, size_t n);
+
+    /// @brief 생산자: 지금까지 기록한 데이터를 모두 버림 (seek 플러시)
+    void   discard();
+
+    size_t size()     const;   ///< 읽기 대기 중인 바이트 (어느 스레드에서나)
+    size_t space()    const { return buf_.size() - size(); }
+    size_t capacity() const { return buf_.size(); }
+
+private:
+    /// pos 부터 n 바이트를 dst 로 (링 끝에서 돌아감)
+    void copy_out(uint64_t pos, uint8_t* dst, size_t n) const;
+
+    std::vector<uint8_t>  buf_;
+    std::atomic<uint64_t> read_  {0};   ///< 누적 읽기 위치 (소비자 CAS, discard 시 생산자도)
+    std::atomic<uint64_t> write_ {0};   ///< 누적 쓰기 위치 (생산자만)
+};
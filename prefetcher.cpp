@@ -0,0 +1,96 @@
+/**
+ * @file prefetcher.cpp
+ * @brief Prefetcher 구현
+ */
+
+#include "prefetcher.h"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#ifdef _WIN32
+#  include <windows.h>
+#endif
+
+void Prefetcher::request(const std::filesystem::path& path, Factory factory, bool background) {
+    if (has(path)) return;
+    clear();
+
+    job_       = std::make_unique<Job>();
+    job_->path = path;
+    Job* job   = job_.get();
+
+    job->thread = std::thread([job, background, factory = std::move(factory)]() {
+        if (background) SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_LOW);
+
+        // 현재 곡의 디코딩 스레드가 계속 도는 중이므로 프로세스 전체가 아니라 이 스레드만 잰다
+        const Uint64 t0   = SDL_GetTicksNS();
+        const double cpu0 = thread_cpu_ms();
+        warm_file(job->path);
+        if (factory) job->player = factory();
+
+        job->cost.open_ms = static_cast<double>(SDL_GetTicksNS() - t0) / SDL_NS_PER_MS;
+        job->cost.cpu_ms  = std::max(0.0, thread_cpu_ms() - cpu0);
+        if (job->player)
+            job->cost.buffer_mb = static_cast<double>(job->player->buffered_bytes()) / (1024.0 * 1024.0);
+
+        std::wcout << L"[미리 열기] " << job->path.filename().wstring() << L" "
+                   << static_cast<int>(job->cost.open_ms) << L"ms"
+                   << (factory && !job->player ? L" (실패)" : L"") << L"\n";
+        job->done.store(true, std::memory_order_release);
+    });
+}
+
+bool Prefetcher::poll(const std::filesystem::path& path, std::unique_ptr<MediaPlayer>& out,
+                      Cost* cost) {
+    if (!ready(path)) return false;
+
+    job_->thread.join();   // 이미 끝났으므로 바로 반환
+    out = std::move(job_->player);
+    if (cost) *cost = job_->cost;
+    job_.reset();
+    return true;
+}
+
+void Prefetcher::clear() {
+    if (!job_) return;
+    // 아직 여는 중일 수 있으므로 join 과 플레이어 해제를 모두 Reaper 에서
+    reaper_.post([job = std::shared_ptr<Job>(std::move(job_))]() {
+        if (job->thread.joinable()) job->thread.join();
+        job->player.reset();
+    });
+}
+
+/**
+ * @brief 파일 앞부분을 읽어 OS 페이지 캐시에 올림 (네트워크 저장소에서 특히 효과)
+ */
+void Prefetcher::warm_file(const std::filesystem::path& path) {
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs.is_open()) return;
+
+    std::vector<char> buf(1u << 20);
+    std::uintmax_t    left = WARM_BYTES;
+    while (left > 0 && ifs.read(buf.data(), static_cast<std::streamsize>(
+                                    std::min<std::uintmax_t>(left, buf.size()))))
+        left -= static_cast<std::uintmax_t>(ifs.gcount());
+}
+
+double Prefetcher::thread_cpu_ms() {
+#ifdef _WIN32
+    FILETIME created, exited, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &created, &exited, &kernel, &user)) return 0.0;
+    auto to_100ns = [](const FILETIME& ft) {
+        return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+    };
+    return static_cast<double>(to_100ns(kernel) + to_100ns(user)) / 10000.0;   // 100ns 단위
+#else
+    timespec ts{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0.0;
+    return static_cast<double>(ts.tv_sec) * 1000.0 + static_cast<double>(ts.tv_nsec) / 1e6;
+#endif
+}
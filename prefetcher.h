@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * @file prefetcher.h
+ * @brief 플레이어 비동기 열기 (전환 대상 + 플레이리스트 다음 항목 미리 열기)
+ *
+ *  백그라운드 스레드에서 파일 앞부분을 읽어 페이지 캐시를 데우고, 플레이어를 만들어
+ *  둔다 (열기 / 스트림 탐색 / 코덱 열기, 비디오는 일시정지 상태로 첫 프레임까지 디코딩).
+ *  메인 스레드는 poll() 로 완료 여부만 확인하고 그동안 계속 렌더링한다.
+ *
+ *  - 모든 메서드는 메인 스레드에서만 호출한다. 결과는 작업별 done 플래그(release/acquire)
+ *    로 넘겨받으므로 별도 락이 없다.
+ *  - 대상이 바뀌면 진행 중인 작업과 쓰이지 않은 플레이어는 Reaper 로 넘긴다
+ *    (열기가 끝날 때까지의 join 과 stop/cleanup 이 UI 를 막지 않도록).
+ */
+
+#include "mediaplayer.h"
+#include "reaper.h"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <thread>
+
+/**
+ * @class Prefetcher
+ * @brief 플레이어 하나를 백그라운드에서 준비
+ */
+class Prefetcher {
+public:
+    /// 플레이어 생성 함수 (작업 스레드에서 호출, 렌더러가 필요 없는 플레이어만)
+    using Factory = std::function<std::unique_ptr<MediaPlayer>()>;
+
+    /// 작업 한 건의 비용 (미리 열기 비용 보고용)
+    struct Cost {
+        double open_ms   = 0.0;   ///< 페이지 캐시 예열 + 플레이어 생성 (벽시계)
+        double cpu_ms    = 0.0;   ///< 같은 구간의 작업 스레드 CPU 시간 (플레이어가 띄운 디코딩 스레드 제외)
+        double buffer_mb = 0.0;   ///< 생성 직후 새 플레이어의 재생 버퍼 (MediaPlayer::buffered_bytes, 모르면 0)
+    };
+
+    /// @param reaper 버려진 작업/플레이어를 넘길 곳 (Prefetcher 보다 오래 살아야 함)
+    explicit Prefetcher(Reaper& reaper) : reaper_(reaper) {}
+    ~Prefetcher() { clear(); }
+
+    Prefetcher(const Prefetcher&)            = delete;
+    Prefetcher& operator=(const Prefetcher&) = delete;
+
+    /**
+     * @brief path 열기 시작 (이미 같은 path 를 준비 중/완료면 무시)
+     * @param factory    비어 있으면 페이지 캐시 예열만 (예: 렌더러가 필요한 이미지)
+     * @param background true 면 낮은 우선순위로 (다음 항목 미리 열기)
+     */
+    void request(const std::filesystem::path& path, Factory factory, bool background = true);
+
+    /**
+     * @brief 준비 결과 확인 (블로킹하지 않음)
+     * @param out  완료 시 준비된 플레이어 (생성 실패 / 예열만 했으면 nullptr)
+     * @param cost 완료 시 작업 비용 (nullptr 이면 무시)
+     * @return path 작업이 끝났으면 true (결과를 넘기고 작업을 비움).
+     *         아직 진행 중이거나 path 가 준비 대상이 아니면 false.
+     */
+    bool poll(const std::filesystem::path& path, std::unique_ptr<MediaPlayer>& out,
+              Cost* cost = nullptr);
+
+    /// @brief path 작업이 끝나 결과를 받을 수 있는지 (poll() 이 true 를 돌려줄지)
+    bool ready(const std::filesystem::path& path) const {
+        return has(path) && job_->done.load(std::memory_order_acquire);
+    }
+
+    /// @brief path 를 준비 중(또는 완료 후 미수령)인지
+    bool has(const std::filesystem::path& path) const { return job_ && job_->path == path; }
+
+    /// @brief 진행 중인 작업과 준비된 플레이어를 Reaper 로 넘김 (SDL_Quit 전에 Reaper::drain 필요)
+    void clear();
+
+private:
+    /// 작업 하나 – 스레드가 player 를 채우고 done 을 올린다
+    struct Job {
+        std::filesystem::path        path;
+        std::unique_ptr<MediaPlayer> player;
+        Cost                         cost;
+        std::atomic<bool>            done{false};
+        std::thread                  thread;
+    };
+
+    static void   warm_file(const std::filesystem::path& path);
+    static double thread_cpu_ms();    ///< 호출 스레드가 쓴 CPU 시간 (ms, 모르면 0)
+
+    static constexpr std::uintmax_t WARM_BYTES = 32u * 1024 * 1024; ///< 페이지 캐시로 미리 읽을 앞부분
+
+    Reaper&              reaper_;
+    std::unique_ptr<Job> job_;   ///< 현재 작업 (없으면 nullptr)
+};
@@ -0,0 +1,234 @@
+/**
+ * @file probecache.cpp
+ * @brief ProbeCache 구현
+ */
+
+#include "probecache.h"
+#include "util.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+ProbeCache& ProbeCache::instance() {
+    static ProbeCache cache;
+    return cache;
+}
+
+bool ProbeCache::file_stamp(const std::string& path, int64_t& size, int64_t& mtime) {
+    std::error_code             ec;
+    const std::filesystem::path p(util::utf8_to_wstring(path));
+    const auto                  sz = std::filesystem::file_size(p, ec);
+    if (ec) return false;
+    const auto                  wt = std::filesystem::last_write_time(p, ec);
+    if (ec) return false;
+    size  = static_cast<int64_t>(sz);
+    mtime = static_cast<int64_t>(wt.time_since_epoch().count());
+    return true;
+}
+
+bool ProbeCache::lookup(const std::string& path, ProbeInfo& out) {
+    int64_t size = 0, mtime = 0;
+    const bool stamped = file_stamp(path, size, mtime);
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    load();
+    auto it = entries_.find(path);
+    if (!stamped || it == entries_.end() ||
+        it->second.size != size || it->second.mtime != mtime) {
+        ++stats_.misses;
+        return false;
+    }
+    it->second.seq = ++seq_;
+    out = it->second.info;
+    ++stats_.hits;
+    return true;
+}
+
+void ProbeCache::store(const std::string& path, const ProbeInfo& info) {
+    Entry e;
+    if (!file_stamp(path, e.size, e.mtime)) return;
+    e.info = info;
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    load();
+    e.seq          = ++seq_;
+    entries_[path] = std::move(e);
+
+    while (entries_.size() > MAX_ENTRIES) {
+        auto oldest = std::min_element(entries_.begin(), entries_.end(),
+            [](const auto& a, const auto& b) { return a.second.seq < b.second.seq; });
+        entries_.erase(oldest);
+    }
+    schedule_save();
+}
+
+void ProbeCache::reject(const std::string& path) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    ++stats_.rejected;
+    if (entries_.erase(path)) schedule_save();
+}
+
+ProbeCache::Stats ProbeCache::stats() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return stats_;
+}
+
+// ── 컨텍스트 ↔ ProbeInfo ─────────────────────────────────────────
+
+ProbeInfo ProbeCache::capture(const AVFormatContext* fmt) {
+    ProbeInfo info;
+    info.duration   = fmt->duration;
+    info.start_time = fmt->start_time;
+    info.bit_rate   = fmt->bit_rate;
+    info.streams.reserve(fmt->nb_streams);
+    for (unsigned i = 0; i < fmt->nb_streams; ++i) {
+        const AVCodecParameters* cp = fmt->streams[i]->codecpar;
+        ProbeInfo::Stream s;
+        s.type        = cp->codec_type;
+        s.codec_id    = cp->codec_id;
+        s.format      = cp->format;
+        s.width       = cp->width;
+        s.height      = cp->height;
+        s.sample_rate = cp->sample_rate;
+        s.channels    = cp->ch_layout.nb_channels;
+        info.streams.push_back(s);
+    }
+    return info;
+}
+
+bool ProbeCache::apply(AVFormatContext* fmt, const ProbeInfo& info) {
+    if (fmt->nb_streams != info.streams.size()) return false;
+    for (unsigned i = 0; i < fmt->nb_streams; ++i) {
+        const AVCodecParameters* cp = fmt->streams[i]->codecpar;
+        if (cp->codec_type != info.streams[i].type ||
+            cp->codec_id   != info.streams[i].codec_id) return false;
+    }
+
+    for (unsigned i = 0; i < fmt->nb_streams; ++i) {
+        AVCodecParameters*       cp = fmt->streams[i]->codecpar;
+        const ProbeInfo::Stream& s  = info.streams[i];
+        if (cp->format < 0) cp->format = s.format;
+        if (cp->codec_type == AVMEDIA_TYPE_VIDEO && (cp->width <= 0 || cp->height <= 0)) {
+            cp->width  = s.width;
+            cp->height = s.height;
+        }
+        if (cp->codec_type == AVMEDIA_TYPE_AUDIO) {
+            if (cp->sample_rate <= 0) cp->sample_rate = s.sample_rate;
+            if (cp->ch_layout.nb_channels <= 0 && s.channels > 0) {
+                av_channel_layout_uninit(&cp->ch_layout);
+                av_channel_layout_default(&cp->ch_layout, s.channels);
+            }
+        }
+    }
+    if (fmt->duration   == AV_NOPTS_VALUE) fmt->duration   = info.duration;
+    if (fmt->start_time == AV_NOPTS_VALUE) fmt->start_time = info.start_time;
+    if (fmt->bit_rate   <= 0)              fmt->bit_rate   = info.bit_rate;
+    return true;
+}
+
+// ── 파일 입출력 ───────────────────────────────────────────────────
+//  한 줄에 한 항목, 탭 구분:
+//  size  mtime  duration  start  bitrate  v  a  s  스트림들  경로
+//  스트림들 = "type:codec:format:w:h:rate:ch" 를 ',' 로 연결 (없으면 "-")
+
+void ProbeCache::load() {
+    if (loaded_) return;
+    loaded_ = true;
+
+    if (char* dir = SDL_GetPrefPath("MP", "MediaPlayer")) {
+        file_ = std::string(dir) + "probecache.txt";
+        SDL_free(dir);
+    }
+    if (file_.empty()) return;
+
+    std::ifstream ifs(std::filesystem::path(util::utf8_to_wstring(file_)));
+    std::string   line;
+    while (std::getline(ifs, line)) {
+        std::istringstream ls(line);
+        Entry              e;
+        std::string        streams, path;
+        ls >> e.size >> e.mtime >> e.info.duration >> e.info.start_time >> e.info.bit_rate
+           >> e.info.video_idx >> e.info.audio_idx >> e.info.subtitle_idx >> streams;
+        if (!ls || !std::getline(ls >> std::ws, path) || path.empty()) continue;
+
+        if (streams != "-") {
+            std::istringstream ss(streams);
+            std::string        item;
+            while (std::getline(ss, item, ',')) {
+                ProbeInfo::Stream s;
+                char              c;
+                std::istringstream is(item);
+                is >> s.type >> c >> s.codec_id >> c >> s.format >> c >> s.width >> c
+                   >> s.height >> c >> s.sample_rate >> c >> s.channels;
+                if (is) e.info.streams.push_back(s);
+            }
+        }
+        e.seq           = ++seq_;
+        entries_[path]  = std::move(e);
+    }
+}
+
+void ProbeCache::schedule_save() {
+    if (file_.empty()) return;
+    dirty_ = true;
+    if (writing_) return;   // 실행 중인 기록 스레드가 끝나기 전에 다시 확인함
+    // writing_ 이 false 면 이전 스레드는 이미 잠금을 놓고 끝나는 중 – join 은 바로 돌아옴
+    if (writer_.joinable()) writer_.join();
+    writing_ = true;
+    writer_  = std::thread(&ProbeCache::writer_loop, this);
+}
+
+void ProbeCache::writer_loop() {
+    std::unique_lock<std::mutex> lk(mutex_);
+    while (dirty_) {
+        dirty_ = false;
+        const Snapshot entries(entries_.begin(), entries_.end());
+        lk.unlock();
+        write_file(file_, entries);   // 파일 I/O 동안 열기 스레드는 막히지 않음
+        lk.lock();
+    }
+    writing_ = false;
+}
+
+void ProbeCache::flush() {
+    std::thread writer;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        writer = std::move(writer_);
+    }
+    if (writer.joinable()) writer.join();   // 남은 변경은 기록 스레드가 모두 씀
+}
+
+void ProbeCache::write_file(const std::string& file, const Snapshot& entries) {
+    if (file.empty()) return;
+
+    const std::filesystem::path target(util::utf8_to_wstring(file));
+    std::filesystem::path       tmp = target;
+    tmp += L".tmp";
+    {
+        std::ofstream ofs(tmp, std::ios::trunc);
+        if (!ofs) return;
+        for (const auto& [path, e] : entries) {
+            const ProbeInfo& in = e.info;
+            ofs << e.size << '\t' << e.mtime << '\t' << in.duration << '\t' << in.start_time
+                << '\t' << in.bit_rate << '\t' << in.video_idx << '\t' << in.audio_idx
+                << '\t' << in.subtitle_idx << '\t';
+            if (in.streams.empty()) ofs << '-';
+            for (size_t i = 0; i < in.streams.size(); ++i) {
+                const ProbeInfo::Stream& s = in.streams[i];
+                ofs << (i ? "," : "") << s.type << ':' << s.codec_id << ':' << s.format << ':'
+                    << s.width << ':' << s.height << ':' << s.sample_rate << ':' << s.channels;
+            }
+            ofs << '\t' << path << '\n';
+        }
+        if (!ofs) return;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, target, ec);   // 쓰다 만 파일이 남지 않도록 교체
+    if (ec) std::cout << "[프로브] 캐시 저장 실패: " << ec.message() << "\n";
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+/**
+ * @file probecache.h
+ * @brief 파일별 스트림 프로브 결과 디스크 캐시
+ *
+ *  avformat_find_stream_info() 는 기본 probesize / analyzeduration 만큼 패킷을 읽고
+ *  디코딩해 보므로 TS/MKV 에서 첫 프레임까지의 시간 대부분을 차지한다. 한 번 연 파일은
+ *  스트림 구성, 코덱 파라미터, 길이, 선택한 스트림 인덱스를 저장해 두고, 다시 열 때는
+ *  작은 프로브 한도로 열고 모자란 파라미터를 캐시 값으로 채운다.
+ *
+ *  - 키: 경로 + 파일 크기 + 수정 시각 (둘 중 하나라도 바뀌면 미스)
+ *  - 저장 위치: SDL_GetPrefPath("MP", "MediaPlayer")/probecache.txt (탭 구분 텍스트)
+ *  - 프로세스 전역 인스턴스, 스레드 안전 (미리 열기 스레드에서도 호출)
+ *  - 파일 기록은 열기 경로 밖에서: store()/reject() 는 변경 표시만 하고, 별도 기록 스레드가
+ *    mutex_ 밖에서 스냅샷을 쓴다 (쓰는 동안 쌓인 변경은 한 번에 다시 씀). 종료 시 flush().
+ */
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// 캐시된 프로브 결과
+struct ProbeInfo {
+    /// 스트림 하나의 핵심 코덱 파라미터
+    struct Stream {
+        int type        = AVMEDIA_TYPE_UNKNOWN;
+        int codec_id    = AV_CODEC_ID_NONE;
+        int format      = -1;   ///< 픽셀 / 샘플 포맷
+        int width       = 0;
+        int height      = 0;
+        int sample_rate = 0;
+        int channels    = 0;
+    };
+
+    std::vector<Stream> streams;
+    int64_t duration     = AV_NOPTS_VALUE;
+    int64_t start_time   = AV_NOPTS_VALUE;
+    int64_t bit_rate     = 0;
+    int     video_idx    = -1;   ///< 선택한 스트림 인덱스 (-1 = 없음)
+    int     audio_idx    = -1;
+    int     subtitle_idx = -1;
+};
+
+/**
+ * @class ProbeCache
+ * @brief ProbeInfo 디스크 캐시 (경로 → 항목, 최대 MAX_ENTRIES 개)
+ */
+class ProbeCache {
+public:
+    /// 누적 통계
+    struct Stats {
+        uint64_t hits     = 0;
+        uint64_t misses   = 0;
+        uint64_t rejected = 0;   ///< 적중했지만 실제 스트림 구성과 달라 버린 수
+    };
+
+    static constexpr int64_t HIT_PROBE_SIZE  = 256 * 1024; ///< 적중 시 probesize (바이트)
+    static constexpr int64_t HIT_ANALYZE_US  = 200000;     ///< 적중 시 analyzeduration (마이크로초)
+
+    static ProbeCache& instance();
+
+    /// @brief path(UTF-8) 의 유효한 항목 조회 (적중/미스 집계)
+    bool lookup(const std::string& path, ProbeInfo& out);
+
+    /// @brief 항목 저장 (파일 기록은 기록 스레드에서)
+    void store(const std::string& path, const ProbeInfo& info);
+
+    /// @brief 항목 삭제 (apply() 실패 시)
+    void reject(const std::string& path);
+
+    Stats stats() const;
+
+    /// @brief 진행 중인 기록을 기다리고 남은 변경을 기록 (종료 시, 메인 스레드)
+    void flush();
+
+    /// @brief 열린 컨텍스트에서 ProbeInfo 를 만든다 (스트림 인덱스는 호출자가 채움)
+    static ProbeInfo capture(const AVFormatContext* fmt);
+
+    /**
+     * @brief 작은 한도로 프로브한 컨텍스트에 캐시 값을 적용
+     *
+     *  스트림 수와 각 스트림의 종류/코덱이 같아야 하며, 프로브가 채우지 못한
+     *  크기/포맷/샘플레이트/채널과 길이만 캐시 값으로 채운다.
+     * @return 스트림 구성이 다르면 false (호출자는 기본 한도로 다시 열어야 함)
+     */
+    static bool apply(AVFormatContext* fmt, const ProbeInfo& info);
+
+private:
+    ProbeCache() = default;
+
+    /// 항목 하나 (파일 크기/수정 시각으로 유효성 확인)
+    struct Entry {
+        int64_t   size  = -1;
+        int64_t   mtime = 0;
+        uint64_t  seq   = 0;   ///< 마지막 사용 순서 (가득 차면 가장 오래된 것부터 제거)
+        ProbeInfo info;
+    };
+
+    static bool file_stamp(const std::string& path, int64_t& size, int64_t& mtime);
+
+    using Snapshot = std::vector<std::pair<std::string, Entry>>;
+
+    void load();                 ///< mutex_ 아래, 최초 1회
+    void schedule_save();        ///< mutex_ 아래 – 변경 표시 후 기록 스레드가 없으면 시작
+    void writer_loop();          ///< 기록 스레드: 변경이 없어질 때까지 스냅샷 기록
+    static void write_file(const std::string& file, const Snapshot& entries);   ///< 잠금 없이
+
+    static constexpr size_t MAX_ENTRIES = 1000;
+
+    mutable std::mutex                     mutex_;
+    bool                                   loaded_ = false;
+    std::string                            file_;   ///< 캐시 파일 경로 (비어 있으면 메모리만)
+    std::unordered_map<std::string, Entry> entries_;
+    uint64_t                               seq_    = 0;
+    Stats                                  stats_;
+    bool                                   dirty_  = false;   ///< 파일에 아직 쓰지 않은 변경
+    bool                                   writing_ = false;  ///< 기록 스레드 실행 중
+    std::thread                            writer_;
+};
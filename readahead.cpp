@@ -0,0 +1,231 @@
+/**
+ * @file readahead.cpp
+ * @brief ReadAhead 구현
+ */
+
+#include "readahead.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+std::unique_ptr<ReadAhead> ReadAhead::open(const std::string& url, size_t bytes) {
+    std::unique_ptr<ReadAhead> ra(new ReadAhead(bytes));
+
+    if (avio_open2(&ra->src_, url.c_str(), AVIO_FLAG_READ, nullptr, nullptr) < 0)
+        return nullptr;
+    ra->file_size_ = avio_size(ra->src_);
+
+    auto* buf = static_cast<uint8_t*>(av_malloc(AVIO_BUF_SIZE));
+    if (!buf) return nullptr;
+    ra->avio_ = avio_alloc_context(buf, static_cast<int>(AVIO_BUF_SIZE), 0, ra.get(),
+                                   &ReadAhead::read_cb, nullptr, &ReadAhead::seek_cb);
+    if (!ra->avio_) { av_free(buf); return nullptr; }
+
+    ra->thread_ = std::thread(&ReadAhead::io_loop, ra.get());
+    std::cout << "[읽기] 앞서 읽기 버퍼 " << ra->ring_.size() / (1024 * 1024) << "MB\n";
+    return ra;
+}
+
+ReadAhead::ReadAhead(size_t bytes)
+    : ring_(std::max(bytes, static_cast<size_t>(CHUNK) * 4))
+{
+    keep_behind_ = ring_.size() / 8;
+}
+
+ReadAhead::~ReadAhead() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        quit_    = true;
+        aborted_ = true;
+    }
+    space_cv_.notify_all();
+    data_cv_.notify_all();
+    if (thread_.joinable()) thread_.join();   // 진행 중인 read 하나는 끝까지 기다림
+
+    if (avio_) {
+        av_freep(&avio_->buffer);   // 내부에서 재할당되었을 수 있으므로 컨텍스트의 것을 해제
+        avio_context_free(&avio_);
+    }
+    if (src_) avio_closep(&src_);
+
+    if (stalls_ > 0 || refills_ > 0 || errors_ > 0)
+        std::cout << "[읽기] 대기 " << stalls_ << "회, 다시 채움 " << refills_ << "회, 오류 "
+                  << errors_ << "회\n";
+}
+
+void ReadAhead::abort() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        aborted_ = true;
+    }
+    data_cv_.notify_all();
+}
+
+ReadAhead::Stats ReadAhead::stats() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    Stats s;
+    s.buffered = static_cast<size_t>(base_ + static_cast<int64_t>(size_) - read_pos_);
+    s.capacity = ring_.size();
+    s.eof      = eof_;
+    s.stalls   = stalls_;
+    s.refills  = refills_;
+    s.errors   = errors_;
+    s.failed   = failed_;
+    return s;
+}
+
+// ── AVIOContext 콜백 (디먹스 스레드) ──────────────────────────────
+
+int ReadAhead::read_cb(void* opaque, uint8_t* buf, int size) {
+    return static_cast<ReadAhead*>(opaque)->read(buf, size);
+}
+
+int64_t ReadAhead::seek_cb(void* opaque, int64_t offset, int whence) {
+    return static_cast<ReadAhead*>(opaque)->seek(offset, whence);
+}
+
+int ReadAhead::read(uint8_t* buf, int size) {
+    std::unique_lock<std::mutex> lk(mutex_);
+
+    auto available = [this] { return base_ + static_cast<int64_t>(size_) - read_pos_; };
+    if (available() <= 0 && !eof_ && !failed_ && !aborted_) {
+        ++stalls_;
+        data_cv_.wait(lk, [&] { return aborted_ || eof_ || failed_ || available() > 0; });
+    }
+    if (aborted_) return AVERROR_EXIT;
+    if (available() <= 0) return failed_ ? AVERROR(EIO) : AVERROR_EOF;
+
+    const size_t n     = std::min(static_cast<size_t>(size), static_cast<size_t>(available()));
+    const size_t idx   = index_of(read_pos_);
+    const size_t first = std::min(n, ring_.size() - idx);
+    std::memcpy(buf, ring_.data() + idx, first);
+    std::memcpy(buf + first, ring_.data(), n - first);
+    read_pos_ += static_cast<int64_t>(n);
+
+    // 읽은 위치에서 keep_behind_ 보다 먼 앞부분은 버려 I/O 스레드에 공간을 준다
+    const size_t behind = static_cast<size_t>(read_pos_ - base_);
+    if (behind > keep_behind_) {
+        const size_t drop = behind - keep_behind_;
+        head_  = (head_ + drop) % ring_.size();
+        base_ += static_cast<int64_t>(drop);
+        size_ -= drop;
+        space_cv_.notify_one();
+    }
+    return static_cast<int>(n);
+}
+
+/**
+ * @brief 버퍼 안이면 읽기 위치만 옮기고, 밖이면 버퍼를 비우고 그 위치부터 다시 채운다
+ */
+int64_t ReadAhead::seek(int64_t offset, int whence) {
+    std::lock_guard<std::mutex> lk(mutex_);
+
+    if (whence & AVSEEK_SIZE) return file_size_ >= 0 ? file_size_ : AVERROR(ENOSYS);
+
+    int64_t target;
+    switch (whence & ~AVSEEK_FORCE) {
+    case SEEK_SET: target = offset;             break;
+    case SEEK_CUR: target = read_pos_ + offset; break;
+    case SEEK_END:
+        if (file_size_ < 0) return AVERROR(ENOSYS);
+        target = file_size_ + offset;
+        break;
+    default:       return AVERROR(EINVAL);
+    }
+    if (target < 0) return AVERROR(EINVAL);
+
+    if (target >= base_ && target <= base_ + static_cast<int64_t>(size_)) {
+        read_pos_ = target;
+        return target;
+    }
+
+    head_     = 0;
+    base_     = target;
+    size_     = 0;
+    read_pos_ = target;
+    eof_      = file_size_ >= 0 && target >= file_size_;
+    ++gen_;
+    ++refills_;
+    space_cv_.notify_one();
+    return target;
+}
+
+// ── I/O 스레드 ────────────────────────────────────────────────────
+
+/**
+ * @brief 버퍼 끝(base_ + size_)부터 CHUNK 단위로 순차 읽기
+ *
+ *  실제 read 는 락 밖에서 한다. 그 사이 버퍼 밖 seek 가 있었으면(gen_ 변경)
+ *  읽은 데이터는 버리고 새 위치부터 다시 읽는다.
+ *  EOF 가 아닌 읽기 오류는 RETRY_MIN_MS 부터 두 배씩 (최대 RETRY_MAX_MS) 기다렸다가
+ *  같은 위치를 다시 읽는다. 대기 중에도 seek / quit 이면 바로 깬다.
+ *  첫 실패부터 RETRY_GIVE_UP_MS 가 지나도록 읽지 못하면 failed_ 를 세우고 멈춘다.
+ */
+void ReadAhead::io_loop() {
+    using clock = std::chrono::steady_clock;
+
+    std::vector<uint8_t> chunk(CHUNK);
+    int64_t              src_pos  = 0;
+    int                  retry_ms = RETRY_MIN_MS;
+    clock::time_point    failing_since{};   // 연속 실패 시작 (성공/seek 시 초기화)
+    bool                 failing  = false;
+
+    std::unique_lock<std::mutex> lk(mutex_);
+    for (;;) {
+        space_cv_.wait(lk, [this] {
+            return quit_ || (!eof_ && !failed_ && ring_.size() - size_ >= static_cast<size_t>(CHUNK));
+        });
+        if (quit_) break;
+
+        const int64_t  fetch = base_ + static_cast<int64_t>(size_);
+        const uint64_t gen   = gen_;
+        lk.unlock();
+
+        int n = AVERROR(EIO);
+        if (src_pos == fetch || avio_seek(src_, fetch, SEEK_SET) >= 0) {
+            src_pos = fetch;
+            n       = avio_read(src_, chunk.data(), CHUNK);
+            if (n > 0) src_pos += n;
+        }
+
+        lk.lock();
+        if (gen != gen_) { retry_ms = RETRY_MIN_MS; failing = false; continue; }
+        if (n <= 0 && (n == AVERROR_EOF || n == 0 || (file_size_ >= 0 && fetch >= file_size_))) {
+            eof_ = true;
+            data_cv_.notify_all();
+            continue;
+        }
+        if (n < 0) {
+            // 일시적 오류로 보고 다시 시도 – 디먹서는 데이터를 기다릴 뿐 EOF 를 보지 않는다
+            ++errors_;
+            const clock::time_point now = clock::now();
+            if (!failing) { failing = true; failing_since = now; }
+            if (now - failing_since >= std::chrono::milliseconds(RETRY_GIVE_UP_MS)) {
+                std::cout << "[읽기] 오류 (" << n << ") 위치 " << fetch << ", "
+                          << RETRY_GIVE_UP_MS / 1000 << "초 동안 실패 – 포기\n";
+                failed_ = true;
+                data_cv_.notify_all();
+                continue;
+            }
+            std::cout << "[읽기] 오류 (" << n << ") 위치 " << fetch << ", " << retry_ms << "ms 후 다시 시도\n";
+            src_pos = -1;   // 실패한 read 뒤의 위치는 믿지 않고 다시 seek
+            space_cv_.wait_for(lk, std::chrono::milliseconds(retry_ms),
+                               [&] { return quit_ || gen != gen_; });
+            retry_ms = std::min(retry_ms * 2, RETRY_MAX_MS);
+            continue;
+        }
+        retry_ms = RETRY_MIN_MS;
+        failing  = false;
+
+        const size_t len   = static_cast<size_t>(n);
+        const size_t idx   = index_of(fetch);
+        const size_t first = std::min(len, ring_.size() - idx);
+        std::memcpy(ring_.data() + idx, chunk.data(), first);
+        std::memcpy(ring_.data(), chunk.data() + first, len - first);
+        size_ += len;
+        data_cv_.notify_all();
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+/**
+ * @file readahead.h
+ * @brief 전용 I/O 스레드 + 링 버퍼로 앞서 읽는 AVIOContext
+ *
+ *  FFmpeg 기본 file 프로토콜은 av_read_frame() 안에서 작은 동기 read 를 하므로,
+ *  NFS/SMB 마운트에서는 네트워크가 잠깐만 멈춰도 디먹스 스레드가 같이 멈춘다.
+ *  ReadAhead 는 별도 스레드가 파일을 큰 단위로 순차적으로 읽어 링 버퍼에 채우고,
+ *  디먹서는 avio() 로 얻은 사용자 정의 AVIOContext 를 통해 버퍼에서만 읽는다.
+ *
+ *  - seek 대상이 버퍼에 이미 있는 구간(읽은 위치 뒤쪽 일부 포함)이면 버퍼 안에서 이동하고,
+ *    벗어나면 버퍼를 비우고 그 위치부터 다시 채운다.
+ *  - 읽은 위치보다 keep_behind_(버퍼의 1/8) 이상 뒤에 있는 데이터는 바로 버려 채울 공간을 만든다.
+ *  - abort() 후에는 읽기 대기 중인 디먹서가 바로 AVERROR_EXIT 로 돌아온다.
+ *  - 파일 끝(AVERROR_EOF 또는 file_size 도달)만 EOF 로 본다. 그 외 읽기 오류(EIO, ETIMEDOUT 등
+ *    네트워크 마운트의 일시적 실패)는 간격을 늘려 가며 다시 시도하고, 디먹서는 그동안 대기한다.
+ *    같은 위치에서 RETRY_GIVE_UP_MS 동안 실패가 이어지면(파일 삭제, 권한, 마운트 해제 등)
+ *    포기하고, 이후 버퍼가 바닥나면 read() 가 AVERROR(EIO) 를 돌려 디먹서 오류 경로로 넘긴다.
+ */
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ReadAhead
+ * @brief 파일 하나에 대한 앞서 읽기 버퍼 (디먹서 스레드 하나 + I/O 스레드 하나)
+ */
+class ReadAhead {
+public:
+    /// 상태 스냅샷 (OSD / 로그용)
+    struct Stats {
+        size_t   buffered = 0;   ///< 읽은 위치 이후 버퍼에 있는 바이트
+        size_t   capacity = 0;   ///< 링 버퍼 크기
+        bool     eof      = false;
+        uint64_t stalls   = 0;   ///< 디먹서가 데이터를 기다린 횟수
+        uint64_t refills  = 0;   ///< 버퍼 밖 seek 로 다시 채운 횟수
+        uint64_t errors   = 0;   ///< 다시 시도한 읽기 오류 횟수
+        bool     failed   = false;   ///< 재시도를 포기함 (버퍼가 비면 읽기 실패)
+    };
+
+    /**
+     * @brief 파일을 열고 I/O 스레드 시작
+     * @param url   파일 경로 (UTF-8, FFmpeg 프로토콜로 열림)
+     * @param bytes 링 버퍼 크기
+     * @return 실패 시 nullptr (호출자는 기본 I/O 로 대신 연다)
+     */
+    static std::unique_ptr<ReadAhead> open(const std::string& url, size_t bytes);
+
+    ~ReadAhead();
+
+    ReadAhead(const ReadAhead&)            = delete;
+    ReadAhead& operator=(const ReadAhead&) = delete;
+
+    /// @brief AVFormatContext::pb 에 넣을 컨텍스트 (AVFMT_FLAG_CUSTOM_IO 와 함께, 소유권 없음)
+    AVIOContext* avio() const { return avio_; }
+
+    /// @brief 읽기 대기를 깨우고 이후 읽기를 실패시킴 (재생 정지 시)
+    void abort();
+
+    Stats stats() const;
+
+private:
+    explicit ReadAhead(size_t bytes);
+
+    static int     read_cb(void* opaque, uint8_t* buf, int size);
+    static int64_t seek_cb(void* opaque, int64_t offset, int whence);
+
+    int     read(uint8_t* buf, int size);
+    int64_t seek(int64_t offset, int whence);
+    void    io_loop();
+
+    /// 파일 위치 pos 의 링 인덱스 (mutex_ 아래)
+    size_t index_of(int64_t pos) const { return (head_ + static_cast<size_t>(pos - base_)) % ring_.size(); }
+
+    static constexpr size_t AVIO_BUF_SIZE = 64 * 1024;    ///< 디먹서 쪽 AVIOContext 버퍼
+    static constexpr int    CHUNK         = 256 * 1024;   ///< I/O 스레드 한 번 읽기 단위
+    static constexpr int    RETRY_MIN_MS  = 100;          ///< 읽기 오류 후 첫 재시도 간격
+    static constexpr int    RETRY_MAX_MS  = 2000;         ///< 재시도 간격 상한 (두 배씩 늘림)
+    static constexpr int    RETRY_GIVE_UP_MS = 30000;     ///< 같은 위치에서 실패가 이만큼 이어지면 포기
+
+    AVIOContext* src_      = nullptr;   ///< 실제 파일 (I/O 스레드 전용)
+    AVIOContext* avio_     = nullptr;   ///< 디먹서에 건네는 사용자 정의 컨텍스트
+    int64_t      file_size_ = -1;
+
+    mutable std::mutex      mutex_;
+    std::condition_variable data_cv_;   ///< 데이터 도착 / abort → 디먹서
+    std::condition_variable space_cv_;  ///< 공간 확보 / seek / quit → I/O 스레드
+
+    std::vector<uint8_t> ring_;
+    size_t   keep_behind_ = 0;   ///< 읽은 위치 뒤로 남겨 둘 바이트 (짧은 뒤로 seek 용)
+    size_t   head_     = 0;      ///< base_ 의 링 인덱스
+    int64_t  base_     = 0;      ///< 버퍼 맨 앞 파일 위치
+    size_t   size_     = 0;      ///< 버퍼에 있는 바이트 ([base_, base_ + size_))
+    int64_t  read_pos_ = 0;      ///< 디먹서 읽기 위치 (base_ 이상 base_ + size_ 이하)
+    uint64_t gen_      = 0;      ///< 버퍼를 비울 때마다 증가 (진행 중이던 I/O 결과 폐기용)
+    bool     eof_      = false;
+    bool     aborted_  = false;
+    bool     quit_     = false;
+    uint64_t stalls_   = 0;
+    uint64_t refills_  = 0;
+    uint64_t errors_   = 0;
+    bool     failed_   = false;  ///< 재시도 포기 – 이후 I/O 스레드는 읽지 않음 (되돌리지 않음)
+
+    std::thread thread_;
+};
@@ -0,0 +1,62 @@
+/**
+ * @file reaper.cpp
+ * @brief Reaper 구현
+ */
+
+#include "reaper.h"
+
+#include <SDL3/SDL.h>
+
+#include <iostream>
+
+Reaper::Reaper()
+    : thread_(&Reaper::loop, this)
+{
+}
+
+void Reaper::retire(std::unique_ptr<MediaPlayer> player) {
+    if (!player) return;
+    player->release_textures();   // 렌더러 객체는 호출(메인) 스레드에서
+    // std::function 은 복사 가능해야 하므로 shared_ptr 로 감싼다
+    post([p = std::shared_ptr<MediaPlayer>(std::move(player))]() mutable {
+        const Uint64 t0 = SDL_GetTicksNS();
+        p.reset();
+        std::cout << "[정리] 플레이어 해제 " << (SDL_GetTicksNS() - t0) / SDL_NS_PER_MS << "ms\n";
+    });
+}
+
+void Reaper::post(std::function<void()> task) {
+    if (!task) return;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (!quit_) {
+            tasks_.push_back(std::move(task));
+            cv_.notify_one();
+            return;
+        }
+    }
+    task();   // 이미 종료됨 – 호출 스레드에서 처리
+}
+
+void Reaper::drain() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        quit_ = true;
+    }
+    cv_.notify_one();
+    if (thread_.joinable()) thread_.join();
+}
+
+void Reaper::loop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lk(mutex_);
+            cv_.wait(lk, [this] { return quit_ || !tasks_.empty(); });
+            if (tasks_.empty()) return;   // quit_ 이고 남은 작업 없음
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+/**
+ * @file reaper.h
+ * @brief 무거운 객체 해제를 메인 스레드 밖에서 처리
+ *
+ *  VideoPlayer 소멸자는 stop()(디코딩 스레드 join) + cleanup() 을 수행하므로
+ *  메인 스레드에서 해제하면 그동안 이벤트/렌더링이 멈춘다. retire() 로 넘기면
+ *  전용 스레드가 넘겨받은 순서대로 해제한다.
+ *
+ *  - retire() 는 메인 스레드에서 호출한다 (텍스처는 그 자리에서 release_textures()).
+ *  - post() 는 어느 스레드에서 호출해도 된다.
+ *  - SDL/BASS 종료 전에 drain() 으로 남은 작업을 모두 끝내야 한다.
+ */
+
+#include "mediaplayer.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class Reaper
+ * @brief 해제 작업 큐 + 작업 스레드 하나
+ */
+class Reaper {
+public:
+    Reaper();
+    ~Reaper() { drain(); }
+
+    Reaper(const Reaper&)            = delete;
+    Reaper& operator=(const Reaper&) = delete;
+
+    /// @brief 플레이어 해제를 넘김 (nullptr 이면 무시, 메인 스레드 전용)
+    void retire(std::unique_ptr<MediaPlayer> player);
+
+    /// @brief 임의 정리 작업 (스레드 join 등) 을 넘김
+    void post(std::function<void()> task);
+
+    /// @brief 큐가 빌 때까지 기다린 뒤 작업 스레드 종료 (이후 post 는 호출 스레드에서 바로 실행)
+    void drain();
+
+private:
+    void loop();
+
+    std::mutex                        mutex_;
+    std::condition_variable           cv_;
+    std::deque<std::function<void()>> tasks_;
+    bool                              quit_ = false;
+    std::thread                       thread_;
+};
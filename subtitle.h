@@ -6,7 +6,7 @@
  *
  *  지원 포맷:
  *    - 외부 파일: .srt / .ass / .ssa (미디어 파일과 같은 이름)
- *    - 내장 자막: FFmpeg AVSubtitle (VideoPlayer decode_loop에서 추가)
+ *    - 내장 자막: FFmpeg AVSubtitle (VideoPlayer demux_loop에서 추가)
  *
  *  우선순위: 외부 .srt > 외부 .ass/.ssa > FFmpeg 내장 스트림
  */
@@ -0,0 +1,185 @@
+/**
+ * @file thumbnailer.cpp
+ * @brief Thumbnailer 구현
+ */
+
+#include "thumbnailer.h"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+Thumbnailer::Thumbnailer(float cpu_share, int width, size_t cache_size)
+    : cpu_share_(std::clamp(cpu_share, 0.05f, 1.0f)),
+      width_(width), cache_size_(cache_size)
+{
+    thread_ = std::thread(&Thumbnailer::worker_loop, this);
+}
+
+Thumbnailer::~Thumbnailer() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        quit_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+    close_file();
+}
+
+// ── 조회 (메인 스레드) ───────────────────────────────────────────
+
+std::shared_ptr<const Thumbnail> Thumbnailer::request(const std::string& path, double secs) {
+    const Key key{ path, static_cast<int64_t>(std::floor(std::max(0.0, secs) / STEP_SEC)) };
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+        if (it->first == key) {
+            cache_.splice(cache_.begin(), cache_, it);
+            return cache_.front().second;
+        }
+    }
+
+    // 이전 대기 요청은 덮어쓴다 – 마우스가 이미 지나간 위치
+    if (!has_pending_ || !(pending_ == key)) {
+        pending_     = key;
+        has_pending_ = true;
+        cv_.notify_one();
+    }
+    return nullptr;
+}
+
+// ── 생성 스레드 ──────────────────────────────────────────────────
+
+void Thumbnailer::worker_loop() {
+    SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_LOW);
+
+    while (true) {
+        Key key;
+        {
+            std::unique_lock<std::mutex> lk(mutex_);
+            cv_.wait(lk, [&] { return quit_.load() || has_pending_; });
+            if (quit_.load()) break;
+            key          = pending_;
+            has_pending_ = false;
+        }
+
+        const auto t0    = std::chrono::steady_clock::now();
+        auto       thumb = generate(key);
+        const auto spent = std::chrono::steady_clock::now() - t0;
+
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            // 실패도 캐시 (nullptr 대신 빈 썸네일) – 같은 위치를 반복해서 시도하지 않도록
+            cache_.emplace_front(key, thumb ? std::shared_ptr<const Thumbnail>(std::move(thumb))
+                                            : std::make_shared<const Thumbnail>());
+            if (cache_.size() > cache_size_) cache_.pop_back();
+        }
+
+        // CPU 점유 제한: 일한 시간에 비례해 쉰다 (quit 시 즉시 깨어남)
+        const auto rest = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            spent * (1.0 / cpu_share_ - 1.0));
+        std::unique_lock<std::mutex> lk(mutex_);
+        cv_.wait_for(lk, rest, [&] { return quit_.load(); });
+    }
+}
+
+/**
+ * @brief 생성용 파일 열기 (같은 파일이면 그대로 재사용)
+ *
+ *  비디오 외 스트림은 AVDISCARD_ALL, 디코더는 단일 스레드 + 키프레임 전용 +
+ *  루프 필터 생략으로 재생 디코더와 CPU 를 최대한 다투지 않게 한다.
+ */
+bool Thumbnailer::open_file(const std::string& path) {
+    if (fmt_ && path == open_path_) return true;
+    close_file();
+
+    if (avformat_open_input(&fmt_, path.c_str(), nullptr, nullptr) < 0) return false;
+    if (avformat_find_stream_info(fmt_, nullptr) < 0) { close_file(); return false; }
+
+    const AVCodec* codec = nullptr;
+    video_idx_ = av_find_best_stream(fmt_, AVMEDIA_TYPE_VIDEO, -1, -1, &codec, 0);
+    if (video_idx_ < 0) { close_file(); return false; }
+
+    for (unsigned i = 0; i < fmt_->nb_streams; ++i)
+        if (static_cast<int>(i) != video_idx_) fmt_->streams[i]->discard = AVDISCARD_ALL;
+
+    dec_ = avcodec_alloc_context3(codec);
+    avcodec_parameters_to_context(dec_, fmt_->streams[video_idx_]->codecpar);
+    dec_->thread_count     = 1;
+    dec_->skip_frame       = AVDISCARD_NONKEY;
+    dec_->skip_loop_filter = AVDISCARD_ALL;
+    dec_->lowres           = std::min(static_cast<int>(codec->max_lowres), 2);  // 지원 코덱(MJPEG 등)만
+    if (avcodec_open2(dec_, codec, nullptr) < 0) { close_file(); return false; }
+
+    open_path_ = path;
+    return true;
+}
+
+void Thumbnailer::close_file() {
+    if (sws_) { sws_freeContext(sws_); sws_ = nullptr; }
+    if (dec_) avcodec_free_context(&dec_);
+    if (fmt_) avformat_close_input(&fmt_);
+    open_path_.clear();
+    video_idx_ = -1;
+}
+
+/**
+ * @brief key 구간 시작 직전 키프레임을 디코딩하여 width_ 너비 RGBA 로 축소
+ */
+std::shared_ptr<Thumbnail> Thumbnailer::generate(const Key& key) {
+    if (!open_file(key.path)) return nullptr;
+
+    const double secs = static_cast<double>(key.bucket) * STEP_SEC;
+    if (av_seek_frame(fmt_, -1, static_cast<int64_t>(secs * AV_TIME_BASE),
+                      AVSEEK_FLAG_BACKWARD) < 0)
+        return nullptr;
+    avcodec_flush_buffers(dec_);
+
+    AVPacket* pkt   = av_packet_alloc();
+    AVFrame*  frame = av_frame_alloc();
+    bool      got   = false;
+
+    // 키프레임 하나면 충분 – 너무 오래 못 찾으면 포기
+    for (int tries = 0; !got && !quit_.load() && tries < 256; ++tries) {
+        if (av_read_frame(fmt_, pkt) < 0) {
+            avcodec_send_packet(dec_, nullptr);
+        } else if (pkt->stream_index != video_idx_) {
+            av_packet_unref(pkt);
+            continue;
+        } else {
+            avcodec_send_packet(dec_, pkt);
+            av_packet_unref(pkt);
+        }
+        got = avcodec_receive_frame(dec_, frame) == 0;
+    }
+
+    std::shared_ptr<Thumbnail> thumb;
+    if (got && frame->width > 0 && frame->height > 0) {
+        thumb         = std::make_shared<Thumbnail>();
+        thumb->width  = width_;
+        thumb->height = std::max(2, (frame->height * width_ / frame->width) & ~1);
+        thumb->secs   = (frame->best_effort_timestamp != AV_NOPTS_VALUE)
+                      ? frame->best_effort_timestamp * av_q2d(fmt_->streams[video_idx_]->time_base)
+                      : secs;
+        thumb->rgba.resize(static_cast<size_t>(thumb->width) * thumb->height * 4);
+
+        sws_ = sws_getCachedContext(sws_,
+            frame->width, frame->height, static_cast<AVPixelFormat>(frame->format),
+            thumb->width, thumb->height, AV_PIX_FMT_RGBA,
+            SWS_BILINEAR, nullptr, nullptr, nullptr);
+
+        uint8_t* dst_data[4]     = { thumb->rgba.data(), nullptr, nullptr, nullptr };
+        int      dst_linesize[4] = { thumb->width * 4, 0, 0, 0 };
+        if (!sws_ || sws_scale(sws_, frame->data, frame->linesize, 0, frame->height,
+                               dst_data, dst_linesize) <= 0)
+            thumb.reset();
+    }
+
+    // 드레인했으면 다음 요청을 위해 디코더 상태 초기화
+    avcodec_flush_buffers(dec_);
+    av_frame_free(&frame);
+    av_packet_free(&pkt);
+    return thumb;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+/**
+ * @file thumbnailer.h
+ * @brief 진행바 호버 미리보기용 썸네일 생성기
+ *
+ *  재생 파이프라인과 완전히 분리된 낮은 우선순위 스레드 하나가
+ *  자체 AVFormatContext / 디코더로 요청 시각 직전 키프레임만 디코딩하여
+ *  작은 RGBA 이미지를 만든다. 결과는 (파일, 시각 구간) 키의 LRU 캐시에 보관.
+ *
+ *  - request() 는 블로킹하지 않는다. 캐시에 없으면 최신 요청 하나만 대기열에 둔다
+ *    (마우스를 움직이는 동안 지나간 위치는 만들지 않음).
+ *  - CPU 점유 제한: 썸네일 하나에 t 초 걸렸으면 t × (1/cpu_share − 1) 초 쉰다.
+ *  - 렌더 API 를 쓰지 않으므로 텍스처 변환은 호출자(메인 스레드)가 한다.
+ */
+
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavcodec/avcodec.h>
+#include <libswscale/swscale.h>
+}
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// 생성된 썸네일 (RGBA32, 행 간격 = width * 4)
+struct Thumbnail {
+    int                  width  = 0;
+    int                  height = 0;
+    double               secs   = 0.0;   ///< 실제 디코딩된 키프레임 시각
+    std::vector<uint8_t> rgba;
+};
+
+/**
+ * @class Thumbnailer
+ * @brief 백그라운드 썸네일 생성 + LRU 캐시
+ */
+class Thumbnailer {
+public:
+    /**
+     * @param cpu_share  생성 스레드가 쓸 최대 CPU 비율 (0.05 ~ 1.0)
+     * @param width      썸네일 너비 (높이는 비율 유지)
+     * @param cache_size 캐시에 보관할 썸네일 수
+     */
+    explicit Thumbnailer(float cpu_share = 0.25f, int width = 160,
+                         size_t cache_size = 128);
+    ~Thumbnailer();
+
+    Thumbnailer(const Thumbnailer&)            = delete;
+    Thumbnailer& operator=(const Thumbnailer&) = delete;
+
+    /**
+     * @brief 썸네일 조회 (메인 스레드, 블로킹 없음)
+     * @param path 비디오 파일 경로 (UTF-8)
+     * @param secs 미리볼 시각 (초)
+     * @return 캐시에 있으면 썸네일, 없으면 nullptr (생성 요청만 등록)
+     */
+    std::shared_ptr<const Thumbnail> request(const std::string& path, double secs);
+
+private:
+    /// 캐시 키: 파일 + STEP_SEC 단위 구간
+    struct Key {
+        std::string path;
+        int64_t     bucket;
+        bool operator==(const Key& o) const { return bucket == o.bucket && path == o.path; }
+    };
+
+    void worker_loop();
+    std::shared_ptr<Thumbnail> generate(const Key& key);
+    bool open_file(const std::string& path);
+    void close_file();
+
+    static constexpr double STEP_SEC = 2.0;   ///< 이 간격 안의 시각은 같은 썸네일 공유
+
+    const float  cpu_share_;
+    const int    width_;
+    const size_t cache_size_;
+
+    // 캐시 / 요청 (mutex_ 보호)
+    std::list<std::pair<Key, std::shared_ptr<const Thumbnail>>> cache_;  ///< 앞쪽이 최근 사용
+    Key                     pending_;             ///< 대기 중인 최신 요청
+    bool                    has_pending_ = false;
+    std::mutex              mutex_;
+    std::condition_variable cv_;
+
+    // 생성 스레드 전용 디코딩 상태 (같은 파일이면 열어 둔 채 재사용)
+    std::string      open_path_;
+    AVFormatContext* fmt_       = nullptr;
+    AVCodecContext*  dec_       = nullptr;
+    SwsContext*      sws_       = nullptr;
+    int              video_idx_ = -1;
+
+    std::atomic<bool> quit_ {false};
+    std::thread       thread_;
+};